@@ -0,0 +1,272 @@
+// Benchmarky ResizableArray<T, R> oproti std::vector a std::deque
+//
+// Každý benchmark beží pre R = 2, 3, 4, tri veľkosti prvku (4, 8 a 64 bajtov)
+// a niekoľko dĺžok poľa. Výber: --benchmark_filter='GetRandom<.*RArray3'
+
+#include <benchmark/benchmark.h>
+
+#include "rarray.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 64-bajtový prvok (jeden cache line)
+struct Payload64 {
+    uint64_t v[8];
+};
+
+template<typename T>
+T makeItem(size_t i) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<T>(i);
+    } else {
+        T item{};
+        item.v[0] = i;
+        return item;
+    }
+}
+
+template<typename T>
+uint64_t keyOf(const T& item) {
+    if constexpr (std::is_arithmetic_v<T>) return static_cast<uint64_t>(item);
+    else return item.v[0];
+}
+
+template<typename T> using RArray2 = ResizableArray<T, 2>;
+template<typename T> using RArray3 = ResizableArray<T, 3>;
+template<typename T> using RArray4 = ResizableArray<T, 4>;
+
+// ==================== JEDNOTNÉ ROZHRANIE KONTAJNEROV ====================
+
+template<typename C> struct Ops;
+
+template<typename T>
+struct StdOps {
+    template<typename C> static void push(C& c, const T& x) { c.push_back(x); }
+    template<typename C> static void pop(C& c) { c.pop_back(); }
+    template<typename C> static const T& at(const C& c, size_t i) { return c[i]; }
+    template<typename C> static size_t size(const C& c) { return c.size(); }
+    template<typename C, typename P> static C filter(const C& c, P pred) {
+        C out;
+        std::copy_if(c.begin(), c.end(), std::back_inserter(out), pred);
+        return out;
+    }
+    template<typename C> static C sub(const C& c, size_t from, size_t to) {
+        return C(c.begin() + static_cast<std::ptrdiff_t>(from), c.begin() + static_cast<std::ptrdiff_t>(to));
+    }
+    template<typename C, typename F> static void scan(const C& c, std::ptrdiff_t stride, F f) {
+        const auto n = static_cast<std::ptrdiff_t>(c.size());
+        for (std::ptrdiff_t i = (stride < 0 ? n - 1 : 0); i >= 0 && i < n; i += stride) f(c[i]);
+    }
+};
+
+template<typename T> struct Ops<std::vector<T>> : StdOps<T> {
+    // ďalší push_back realokuje
+    static bool atGrowthPoint(const std::vector<T>& c) { return c.size() == c.capacity(); }
+};
+template<typename T> struct Ops<std::deque<T>> : StdOps<T> {
+    // deque nemá globálnu realokáciu - meria sa bežný push_back
+    static bool atGrowthPoint(const std::deque<T>&) { return true; }
+};
+
+template<typename T, size_t R>
+struct Ops<ResizableArray<T, R>> {
+    using C = ResizableArray<T, R>;
+    static void push(C& c, const T& x) { c.push_back(x); }
+    static void pop(C& c) { c.shrink(); }
+    static const T& at(const C& c, size_t i) { return c.get_unchecked(i); }
+    static size_t size(const C& c) { return c.length(); }
+    template<typename P> static C filter(const C& c, P pred) { return c.filter(pred); }
+    static C sub(const C& c, size_t from, size_t to) { return c.sub_rarray(from, to); }
+    template<typename F> static void scan(const C& c, std::ptrdiff_t stride, F f) { c.scan(stride, f); }
+    // ďalší push_back spustí rebuild (N == B^R)
+    static bool atGrowthPoint(const C& c) { return c.length() == c.layout_.growAt; }
+};
+
+template<typename C>
+C filled(size_t n) {
+    using T = typename C::value_type;
+    C c;
+    for (size_t i = 0; i < n; ++i) Ops<C>::push(c, makeItem<T>(i));
+    return c;
+}
+
+template<typename C>
+void setItems(benchmark::State& state, size_t perIteration) {
+    using T = typename C::value_type;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * perIteration));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * perIteration * sizeof(T)));
+}
+
+// ==================== BENCHMARKY ====================
+
+template<typename C>
+void BM_PushBack(benchmark::State& state) {
+    using T = typename C::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (size_t i = 0; i < n; ++i) Ops<C>::push(c, makeItem<T>(i));
+        benchmark::DoNotOptimize(Ops<C>::size(c));
+    }
+    setItems<C>(state, n);
+}
+
+template<typename C>
+void BM_Shrink(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C source = filled<C>(n);
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = source;
+        state.ResumeTiming();
+        for (size_t i = 0; i < n; ++i) Ops<C>::pop(c);
+        benchmark::DoNotOptimize(Ops<C>::size(c));
+    }
+    setItems<C>(state, n);
+}
+
+template<typename C>
+void BM_GetSequential(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) sum += keyOf(Ops<C>::at(c, i));
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems<C>(state, n);
+}
+
+template<typename C>
+void BM_GetRandom(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    std::vector<size_t> idx(4096);
+    std::mt19937_64 rng(42);
+    for (size_t& i : idx) i = rng() % n;
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t i : idx) sum += keyOf(Ops<C>::at(c, i));
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems<C>(state, idx.size());
+}
+
+template<typename C>
+void BM_Iterate(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& x : c) sum += keyOf(x);
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems<C>(state, n);
+}
+
+// Prechod odzadu (time-series od konca) a s krokom 16 prvkov
+template<typename C>
+void BM_ScanStrided(benchmark::State& state, std::ptrdiff_t stride) {
+    using T = typename C::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        Ops<C>::scan(c, stride, [&](const T& x) { sum += keyOf(x); });
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems<C>(state, n / static_cast<size_t>(stride < 0 ? -stride : stride));
+}
+
+template<typename C> void BM_ScanReverse(benchmark::State& state) { BM_ScanStrided<C>(state, -1); }
+template<typename C> void BM_ScanStride16(benchmark::State& state) { BM_ScanStrided<C>(state, 16); }
+
+template<typename C>
+void BM_Filter(benchmark::State& state) {
+    using T = typename C::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    for (auto _ : state) {
+        C out = Ops<C>::filter(c, [](const T& x) { return keyOf(x) % 3 != 0; });
+        benchmark::DoNotOptimize(Ops<C>::size(out));
+    }
+    setItems<C>(state, n);
+}
+
+template<typename C>
+void BM_SubRange(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    for (auto _ : state) {
+        C out = Ops<C>::sub(c, n / 7, n - n / 5);
+        benchmark::DoNotOptimize(Ops<C>::size(out));
+    }
+    setItems<C>(state, n - n / 5 - n / 7);
+}
+
+template<typename C>
+void BM_Copy(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const C c = filled<C>(n);
+    for (auto _ : state) {
+        C copy(c);
+        benchmark::DoNotOptimize(Ops<C>::size(copy));
+    }
+    setItems<C>(state, n);
+}
+
+// Najdrahší jednotlivý push_back: ten, ktorý spustí rebuild (ResizableArray)
+// alebo realokáciu (std::vector). Pole sa pripraví mimo merania.
+template<typename C>
+void BM_GrowthSpike(benchmark::State& state) {
+    using T = typename C::value_type;
+    const size_t n = static_cast<size_t>(state.range(0));
+    C source = filled<C>(n);
+    while (!Ops<C>::atGrowthPoint(source)) Ops<C>::push(source, makeItem<T>(Ops<C>::size(source)));
+    state.counters["size"] = static_cast<double>(Ops<C>::size(source));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = source;
+        state.ResumeTiming();
+        Ops<C>::push(c, makeItem<T>(0));
+        benchmark::DoNotOptimize(Ops<C>::size(c));
+    }
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+}
+
+#define RARRAY_BENCH_CONTAINERS(fn, T)                      \
+    BENCHMARK_TEMPLATE(fn, std::vector<T>)->Apply(sizes);   \
+    BENCHMARK_TEMPLATE(fn, std::deque<T>)->Apply(sizes);    \
+    BENCHMARK_TEMPLATE(fn, RArray2<T>)->Apply(sizes);       \
+    BENCHMARK_TEMPLATE(fn, RArray3<T>)->Apply(sizes);       \
+    BENCHMARK_TEMPLATE(fn, RArray4<T>)->Apply(sizes)
+
+#define RARRAY_BENCH_TYPES(fn)                 \
+    RARRAY_BENCH_CONTAINERS(fn, uint32_t);     \
+    RARRAY_BENCH_CONTAINERS(fn, uint64_t);     \
+    RARRAY_BENCH_CONTAINERS(fn, Payload64)
+
+RARRAY_BENCH_TYPES(BM_PushBack);
+RARRAY_BENCH_TYPES(BM_Shrink);
+RARRAY_BENCH_TYPES(BM_GetSequential);
+RARRAY_BENCH_TYPES(BM_GetRandom);
+RARRAY_BENCH_TYPES(BM_Iterate);
+RARRAY_BENCH_TYPES(BM_ScanReverse);
+RARRAY_BENCH_TYPES(BM_ScanStride16);
+RARRAY_BENCH_TYPES(BM_Filter);
+RARRAY_BENCH_TYPES(BM_SubRange);
+RARRAY_BENCH_TYPES(BM_Copy);
+RARRAY_BENCH_TYPES(BM_GrowthSpike);
+
+} // namespace
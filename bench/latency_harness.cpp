@@ -0,0 +1,208 @@
+// Meranie chvostových latencií push_back/shrink na dlhých stopách operácií
+//
+// Na rozdiel od benchmarkov (priepustnosť) sa tu meria každá operácia zvlášť
+// a vypíšu sa p50/p99/p999/max a operácie, ktoré spôsobili najhoršie prípady
+// (index v stope, druh, N pred operáciou, B). Okrem náhodnej zmesi obsahuje
+// aj nepriateľské stopy, ktoré sa točia okolo prahov rebuildu
+// N == B^R a N == (B/4)^R a okolo hranice combineBlocks/splitBlocks.
+//
+//   rarray_latency [--ops N] [--pattern mixed|grow-edge|shrink-edge|block-edge|all]
+//                  [--incremental] [--top K] [--seed S]
+
+#include "rarray.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Op : uint8_t { Push, Shrink };
+
+struct Sample {
+    uint64_t ns;
+    size_t   step;   // poradie v stope
+    size_t   length; // N pred operáciou
+    size_t   B;      // B pred operáciou
+    Op       op;
+};
+
+struct Options {
+    size_t      ops = 2'000'000;
+    std::string pattern = "all";
+    bool        incremental = false;
+    size_t      top = 10;
+    uint64_t    seed = 1;
+};
+
+// Stopa = postupnosť operácií; generátor dostane aktuálne pole a rozhodne o ďalšej
+template<size_t R>
+using Arr = ResizableArray<uint64_t, R>;
+
+template<size_t R, typename Next>
+std::vector<Sample> runTrace(Arr<R>& arr, size_t ops, Next next) {
+    using clock = std::chrono::steady_clock;
+    std::vector<Sample> samples;
+    samples.reserve(ops);
+
+    for (size_t step = 0; step < ops; ++step) {
+        const Op op = next(arr);
+        const size_t len = arr.length();
+        const size_t B = arr.getParameterB();
+
+        const auto t0 = clock::now();
+        if (op == Op::Push) arr.push_back(step);
+        else arr.shrink();
+        const auto t1 = clock::now();
+
+        samples.push_back({static_cast<uint64_t>(
+                               std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()),
+                           step, len, B, op});
+    }
+    return samples;
+}
+
+void report(const char* name, size_t r, std::vector<Sample> samples, size_t top) {
+    if (samples.empty()) return;
+
+    std::vector<uint64_t> ns(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) ns[i] = samples[i].ns;
+    std::sort(ns.begin(), ns.end());
+    auto pct = [&](double p) {
+        size_t k = static_cast<size_t>(p * static_cast<double>(ns.size() - 1));
+        return ns[k];
+    };
+
+    std::printf("%-12s R=%zu ops=%zu  p50=%lluns p99=%lluns p999=%lluns max=%lluns\n", name, r, ns.size(),
+                static_cast<unsigned long long>(pct(0.50)), static_cast<unsigned long long>(pct(0.99)),
+                static_cast<unsigned long long>(pct(0.999)), static_cast<unsigned long long>(ns.back()));
+
+    top = std::min(top, samples.size());
+    std::partial_sort(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(top), samples.end(),
+                      [](const Sample& a, const Sample& b) { return a.ns > b.ns; });
+    for (size_t i = 0; i < top; ++i) {
+        const Sample& s = samples[i];
+        std::printf("    %10lluns  step %-9zu %-6s N=%-10zu B=%zu\n", static_cast<unsigned long long>(s.ns), s.step,
+                    s.op == Op::Push ? "push" : "shrink", s.length, s.B);
+    }
+}
+
+template<size_t R>
+void runPatterns(const Options& opt) {
+    auto fresh = [&] {
+        Arr<R> arr;
+        arr.setIncrementalRebuild(opt.incremental);
+        return arr;
+    };
+    auto wants = [&](const char* name) { return opt.pattern == "all" || opt.pattern == name; };
+
+    if (wants("mixed")) {
+        // náhodná zmes s miernou prevahou push_back (pole pomaly rastie)
+        Arr<R> arr = fresh();
+        std::mt19937_64 rng(opt.seed);
+        report("mixed", R, runTrace<R>(arr, opt.ops, [&](const Arr<R>& a) {
+            return (a.empty() || rng() % 100 < 55) ? Op::Push : Op::Shrink;
+        }), opt.top);
+    }
+
+    if (wants("grow-edge")) {
+        // rast po prah N == B^R, potom striedanie okolo neho (a tak znova pre ďalšie B)
+        Arr<R> arr = fresh();
+        size_t phase = 0;
+        report("grow-edge", R, runTrace<R>(arr, opt.ops, [&](const Arr<R>& a) {
+            // až po N == B^R (ďalší push spustí rebuild), potom 64 krokov kmitania
+            if (a.length() < a.layout_.growAt && phase == 0) return Op::Push;
+            phase = (phase + 1) % 64;
+            return (phase % 2) ? Op::Push : Op::Shrink;
+        }), opt.top);
+    }
+
+    if (wants("shrink-edge")) {
+        // naplniť, potom zmenšovať k prahu N == (B/4)^R a kmitať okolo neho
+        Arr<R> arr = fresh();
+        const size_t fill = std::min<size_t>(opt.ops / 4, size_t{1} << 20);
+        bool filled = false;
+        size_t phase = 0;
+        report("shrink-edge", R, runTrace<R>(arr, opt.ops, [&](const Arr<R>& a) {
+            if (!filled) {
+                if (a.length() < fill) return Op::Push;
+                filled = true;
+            }
+            if (a.empty()) return Op::Push;
+            if (a.length() > a.layout_.shrinkAt && phase == 0) return Op::Shrink;
+            phase = (phase + 1) % 64;
+            return (phase % 2) ? Op::Shrink : Op::Push;
+        }), opt.top);
+    }
+
+    if (wants("block-edge")) {
+        // kmitanie na hranici posledného B-bloku: ďalší push spustí combineBlocks
+        // a shrink po ňom splitBlocks (pri R = 2 len alokácia/uvoľnenie B-bloku)
+        Arr<R> arr = fresh();
+        for (size_t i = 0; i < 3 * (size_t{1} << 16); ++i) arr.push_back(i);
+        auto atEdge = [](const Arr<R>& a) {
+            const size_t B = a.getParameterB();
+            return a.n0_ == B && (R == 2 || a.n_[1] == 2 * B);
+        };
+        while (!atEdge(arr)) arr.push_back(0);
+        bool up = true;
+        report("block-edge", R, runTrace<R>(arr, opt.ops, [&](const Arr<R>&) {
+            up = !up;
+            return up ? Op::Shrink : Op::Push;
+        }), opt.top);
+    }
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        auto value = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+        if (!std::strcmp(a, "--ops")) {
+            const char* v = value();
+            if (!v) return false;
+            opt.ops = std::strtoull(v, nullptr, 10);
+        } else if (!std::strcmp(a, "--pattern")) {
+            const char* v = value();
+            if (!v) return false;
+            opt.pattern = v;
+        } else if (!std::strcmp(a, "--top")) {
+            const char* v = value();
+            if (!v) return false;
+            opt.top = std::strtoull(v, nullptr, 10);
+        } else if (!std::strcmp(a, "--seed")) {
+            const char* v = value();
+            if (!v) return false;
+            opt.seed = std::strtoull(v, nullptr, 10);
+        } else if (!std::strcmp(a, "--incremental")) {
+            opt.incremental = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "usage: %s [--ops N] [--pattern mixed|grow-edge|shrink-edge|block-edge|all]"
+                     " [--incremental] [--top K] [--seed S]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::printf("incremental rebuild: %s\n", opt.incremental ? "on" : "off");
+    runPatterns<2>(opt);
+    runPatterns<3>(opt);
+    runPatterns<4>(opt);
+    return 0;
+}
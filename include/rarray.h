@@ -1,11 +1,73 @@
 #ifndef PROJEKT_RARRAY_H
 #define PROJEKT_RARRAY_H
 
+#include <bit>
+#include <compare>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+// Politiky vykonávania pre paralelné operácie ResizableArray.
+// Vlastné značky, aby rarray.h nemusel zahŕňať <execution> (v libstdc++ s TBB
+// to vyžaduje linkovať -ltbb); std::execution::seq/par/... pridá rarray_execution.h.
+namespace rarray_exec {
+    struct sequenced_policy {};
+    struct parallel_policy {
+        size_t threads = 0; // 0 = std::thread::hardware_concurrency()
+    };
+    inline constexpr sequenced_policy seq{};
+    inline constexpr parallel_policy par{};
+
+    // Známe politiky majú člen parallel (beží sa na viacerých vláknach?)
+    template<typename P> struct policy_traits {};
+    template<> struct policy_traits<sequenced_policy> { static constexpr bool parallel = false; };
+    template<> struct policy_traits<parallel_policy>  { static constexpr bool parallel = true; };
+
+    template<typename P>
+    concept execution_policy = requires { policy_traits<std::remove_cvref_t<P>>::parallel; };
+} // namespace rarray_exec
+
+template<typename T, size_t R = 3>
+class RArrayView;
+
+// Meranie combineBlocks/splitBlocks/rebuild (počty volaní a histogram latencií
+// v stats()). Zapína sa cez -DRARRAY_INSTRUMENT=1; vypnuté nepridá do poľa nič
+// a stats() hlási pri týchto operáciách nuly.
+#ifndef RARRAY_INSTRUMENT
+#define RARRAY_INSTRUMENT 0
+#endif
+
+#if RARRAY_INSTRUMENT
+#include <chrono>
+#endif
+
+// Počty a latencie jednej vnútornej operácie ResizableArray
+struct RArrayOpStats {
+    static constexpr size_t BUCKETS = 40;
+
+    size_t   calls   = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs   = 0;
+    // latencyLog2[k] = počet volaní s trvaním v [2^(k-1), 2^k) ns (k = bit_width)
+    size_t latencyLog2[BUCKETS] = {};
+
+    void record(uint64_t ns) {
+        calls   += 1;
+        totalNs += ns;
+        if (ns > maxNs) maxNs = ns;
+        const size_t k = static_cast<size_t>(std::bit_width(ns));
+        latencyLog2[k < BUCKETS ? k : BUCKETS - 1] += 1;
+    }
+};
+
 // Optimálne zmeniteľné pole - inteligentná alternatíva k std::vector
 // Používa menej pamäte (N + O(N^1/r) namiesto až 2N) ale za cenu trochu pomalších push_back/shrink operácií
 // Parameter R určuje trade-off: väčšie R = menej pamäte, ale pomalšie operácie
@@ -14,13 +76,24 @@ class ResizableArray {
 public:
     // ==================== ZÁKLADNÉ VECI ====================
 
+    using value_type = T;
+    using size_type  = size_t;
+
+    // Zarovnanie začiatku každého bloku: aspoň cache line (64 B), aby SIMD
+    // slučky nad celým blokom mohli používať zarovnané načítania
+    static constexpr size_t BLOCK_ALIGN = (alignof(T) > 64 ? alignof(T) : 64);
+
     // Vytvorí prázdne pole
     ResizableArray();
 
+    // Prázdne pole, ktorého bloky aj polia blokov sa alokujú z daného zdroja pamäte
+    // (napr. arény lokálnej pre NUMA uzol). Zdroj musí žiť dlhšie ako pole.
+    explicit ResizableArray(std::pmr::memory_resource* resource);
+
     // Uprace všetko
     ~ResizableArray();
 
-    // Skopíruje celé pole (pomalá operácia!)
+    // Skopíruje celé pole: rovnaká geometria, každý blok jedna alokácia a jedna hromadná kópia
     ResizableArray(const ResizableArray& other);
 
     // Presunie pole (rýchle, bez kopírovania)
@@ -38,6 +111,18 @@ public:
     // Trvá O(r) v priemere, niekedy môže trvať dlhšie keď sa musia presúvať bloky
     void push_back(const T& item);
 
+    // To isté, ale prvok sa presunie (bez kópie)
+    void push_back(T&& item);
+
+    // Názov operácie z pôvodného článku (grow/shrink), to isté ako push_back
+    void grow(const T& item) { push_back(item); }
+    void grow(T&& item) { push_back(std::move(item)); }
+
+    // Vytvorí prvok priamo na konci z argumentov jeho konštruktora
+    // Vráti referenciu na nový prvok
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+
     // Odstráni posledný prvok (ako pop_back)
     // Hodí výnimku ak je pole prázdne
     void shrink();
@@ -49,120 +134,380 @@ public:
     // To isté ale pre konštantné objekty
     const T& get(size_t index) const;
 
+    // Rovnaké ako get(), ale bez kontroly hraníc (pre horúce slučky v release buildoch)
+    // Index musí byť < length(), inak je správanie nedefinované
+    T& get_unchecked(size_t index);
+    const T& get_unchecked(size_t index) const;
+
+    // Hromadné get(): out[k] = get(idx[k]) pre k < n
+    // Úrovne sa určia pre celú dávku naraz (AVX2/NEON porovnania so začiatkami
+    // úrovní) a cieľové prvky sa prefetchujú skôr, než sa čítajú, takže výpadky
+    // cache sa prekrývajú. Pri indexe mimo rozsahu hodí std::out_of_range
+    // (out môže byť dovtedy čiastočne zapísané).
+    void get_many(const size_t* idx, size_t n, T* out) const;
+
     // Zmení hodnotu prvku na danej pozícii
     void set(size_t index, const T& item);
+    void set(size_t index, T&& item);
 
     // ==================== INE OPERÁCIE ====================
 
-    // Pre iný ResizableArray
-    void push_back_all(const ResizableArray& other) {
-        for (size_t i = 0; i < other.length(); ++i) {
-            push_back(other.get(i));
-        }
-    }
+    // Hromadné pridanie na koniec. Pre forward iterátory sa vopred zistí počet
+    // prvkov, z neho výsledné B a prvky sa kopírujú priamo do blokov
+    // (bez medzi-rebuildov, pre triviálne kopírovateľné T po celých kusoch).
+    // Rozsah nesmie ukazovať do tohto poľa. Ak kopírovanie prvku hodí výnimku
+    // počas prestavby na novú geometriu, pole ostane prázdne (ako pri rebuild()).
+    template<typename InputIt>
+    void append(InputIt first, InputIt last);
+
+    void append(std::span<const T> items) { append(items.begin(), items.end()); }
+
+    // Pre iný ResizableArray (segmenty zdroja sa kopírujú po súvislých kusoch)
+    void push_back_all(const ResizableArray& other);
 
     // Pre obyčajné pole
     void push_back_all(const T* arr, size_t size) {
-        for (size_t i = 0; i < size; ++i) {
-            push_back(arr[i]);
-        }
+        append(arr, arr + size);
     }
     // Iny variant
     template<size_t N>
     void push_back_all(const T (&arr)[N]) {
-        for (size_t i = 0; i < N; ++i) {
-            push_back(arr[i]);
-        }
+        append(arr, arr + N);
     }
 
     // Pre vector
     void push_back_all(const std::vector<T>& vec) {
-        for (const auto& x : vec) {
-            push_back(x);
-        }
+        append(vec.begin(), vec.end());
     }
 
+    // Pripraví pole na aspoň n prvkov: hneď zvolí B, pri ktorom n <= B^R
+    // (jediný rebuild namiesto všetkých medzi INITIAL_B a výsledným B)
+    // a predalokuje polia blokov každej úrovne. Menšie n nerobí nič.
+    void reserve(size_t n);
+
+    // Opak reserve(): vráti B na najmenšie, pri ktorom sa prvky zmestia,
+    // a uvoľní nevyužitú kapacitu polí blokov na každej úrovni.
+    void shrink_to_fit();
+
+    // Kópia prvkov [from, to). Geometria výsledku sa zvolí raz podľa dĺžky
+    // a kopírujú sa celé úseky blokov (O(počet blokov) + kopírovanie dát).
     ResizableArray sub_rarray(size_t from, size_t to) const;
 
+    // Pohľad na prvky [from, to) bez kopírovania, vytvorí sa v O(1).
+    // Platí, kým sa štruktúra poľa nezmení (ako iterátory).
+    RArrayView<T, R> view(size_t from, size_t to) const { return RArrayView<T, R>(*this, from, to); }
+    RArrayView<T, R> view() const { return RArrayView<T, R>(*this, 0, length()); }
+
+    // Nové pole s prvkami, ktoré spĺňajú pred (v pôvodnom poradí)
+    // Pre triviálne kopírovateľné T sa filtruje po blokoch priamo do posledného
+    // bloku výsledku bez skokov (s AVX2 po 8/4 prvkoch naraz); pred sa volá
+    // aj pre vyradené prvky, takže má byť bez vedľajších účinkov.
     template<typename Predicate>
     ResizableArray<T, R> filter(Predicate pred) const;
 
+    // ==================== PARALELNÉ OPERÁCIE ====================
+    //
+    // Varianty s politikou (rarray_exec::par alebo std::execution::par cez
+    // rarray_execution.h) rozdelia prvky po súvislých kusoch blokov medzi vlákna.
+    // Každé vlákno vyrobí vlastný čiastkový výsledok a tie sa na konci spoja
+    // presunom (nie kópiou) do výstupu. Pre seq, alebo keď je prvkov málo, sa
+    // použije rovnaká cesta na jednom vlákne. Funkcie f/pred sa volajú súbežne.
+
+    template<typename Policy, typename Predicate>
+        requires rarray_exec::execution_policy<Policy>
+    ResizableArray filter(Policy&& policy, Predicate pred) const;
+
+    template<typename Policy>
+        requires rarray_exec::execution_policy<Policy>
+    ResizableArray sub_rarray(Policy&& policy, size_t from, size_t to) const;
+
+    template<typename U, typename Policy>
+        requires rarray_exec::execution_policy<Policy>
+    ResizableArray<U, R> flatten(Policy&& policy) const;
+
+    // f(T&) pre každý prvok (na mieste)
+    template<typename Policy, typename F>
+        requires rarray_exec::execution_policy<Policy>
+    void for_each(Policy&& policy, F f);
+
+    // Nové pole s f(x) pre každý prvok x
+    template<typename Policy, typename F>
+        requires rarray_exec::execution_policy<Policy>
+    ResizableArray<std::decay_t<std::invoke_result_t<F&, const T&>>, R>
+    transform(Policy&& policy, F f) const;
+
+    // ==================== REDUKCIE ====================
+
+    // Ľavý fold: op(...op(op(init, a[0]), a[1])..., a[n-1])
+    template<typename U, typename BinaryOp>
+    U reduce(U init, BinaryOp op) const;
+
+    // Súčet prvkov (T{} pre prázdne pole); po blokoch s viacerými akumulátormi,
+    // takže pre float/double môže poradie sčítania ovplyvniť zaokrúhlenie
+    T sum() const;
+
+    // Najmenší / najväčší prvok (podľa operator<), pre prázdne pole hodí std::out_of_range
+    T min() const;
+    T max() const;
+
+    // Počet prvkov, ktoré spĺňajú pred
+    template<typename Predicate>
+    size_t count_if(Predicate pred) const;
+
+    // Index prvého prvku rovného value, alebo length() ak taký nie je
+    size_t find(const T& value) const;
+
     template<typename U>
     ResizableArray<U, R> flatten() const;
 
     // ==================== UŽITOČNÉ INFO ====================
 
     // Koľko prvkov je v poli
-    size_t length() const { return N_; }
+    size_t length() const { return N_ + (old_ ? carryLength() + old_->N_ : 0); }
 
     // Je pole prázdne?
-    bool empty() const { return N_ == 0; }
+    bool empty() const { return length() == 0; }
 
     // Parameter B (veľkosť najmenších blokov)
     // Užitočné na debugovanie a testovanie
     size_t getParameterB() const { return B_; }
 
+    // Zdroj pamäte, z ktorého pole alokuje
+    // (kópia ako pri std::pmr kontajneroch dostane predvolený zdroj)
+    std::pmr::memory_resource* resource() const { return resource_; }
+
+    // Bloky úrovní fromLevel..R-1 (B^fromLevel a väčšie) sa budú alokovať z mr,
+    // napr. z FileBackedResource (rarray_storage.h) pre polia väčšie než RAM.
+    // Tabuľky a B-bloky na konci, ktoré berú push_back/shrink, ostanú v resource_.
+    // Platí pre nové bloky; existujúce si nesú svoj zdroj. mr == nullptr vypne.
+    // Ako resource_ sa prenáša presunom, nie kópiou.
+    void setLargeBlockResource(size_t fromLevel, std::pmr::memory_resource* mr) {
+        if (mr && (fromLevel == 0 || fromLevel >= R)) {
+            throw std::invalid_argument("setLargeBlockResource: level must be in [1, R)");
+        }
+        largeResource_ = mr;
+        largeFrom_ = (mr ? fromLevel : R);
+        releaseSpares(); // odložené bloky môžu byť z iného zdroja
+    }
+    std::pmr::memory_resource* largeBlockResource() const { return largeResource_; }
+    size_t largeBlockLevel() const { return largeFrom_; }
+
+    // ==================== ŠTATISTIKY ====================
+
+    // Pamäť poľa po úrovniach (všetko v bajtoch) a čo sa dialo pri prestavbách.
+    // Overhead (totalBytes - elementBytes) by mal byť O(N^(1/r)).
+    struct Stats {
+        size_t length = 0;
+        size_t B = 0;
+        size_t elementBytes = 0;    // length * sizeof(T)
+        size_t blockBytes = 0;      // kapacita všetkých blokov (bez old_)
+        size_t blocks[R] = {};      // n_[i]
+        size_t slackBytes[R] = {};  // nevyužité miesto v blokoch úrovne i
+        size_t tableBytes[R] = {};  // tabuľky blokov (kapacita) + hlavičky DataBlock
+        size_t spareBytes = 0;      // odložené bloky (pool / retainSpareTail)
+        size_t migratingBytes = 0;  // celá stará štruktúra počas postupného rebuildu
+        size_t totalBytes = 0;      // všetko okrem samotného objektu
+        size_t peakRebuildBytes = 0; // najviac bajtov blokov naraz počas prestavby
+
+        // len s RARRAY_INSTRUMENT, inak nuly
+        RArrayOpStats combine;
+        RArrayOpStats split;
+        RArrayOpStats rebuild;
+
+        size_t overheadBytes() const { return totalBytes - elementBytes; }
+    };
+
+    // Prejde tabuľky blokov: O(počet blokov)
+    Stats stats() const;
+
+    // Vynuluje peakRebuildBytes a počítadlá operácií
+    void resetStats();
+
+    // ==================== POOL BLOKOV ====================
+
+    // Zapne/vypne pool: pre každú úroveň sa odloží jeden uvoľnený blok veľkosti B^i
+    // a ďalšia alokácia rovnakej veľkosti ho použije znova. Striedanie push_back/shrink
+    // na hranici bloku (aj combineBlocks/splitBlocks) tak nevolá alokátor.
+    // Stojí to najviac B + B^2 + ... + B^(r-1) prvkov pamäte navyše, preto je vypnutý.
+    void setBlockPool(bool enabled) {
+        pool_ = enabled;
+        if (!enabled) releaseSpares();
+    }
+    bool blockPool() const { return pool_; }
+
+    // Hysteréza na konci poľa: keď shrink vyprázdni posledný B-blok (aj blok
+    // vzniknutý zo splitBlocks), blok sa nezmaže, ale odloží pre ďalší push_back.
+    // Ďalší vyprázdnený blok sa už zmaže, takže navyše je najviac jeden B-blok a
+    // záruka O(N^(1/r)) pamäte navyše ostáva zachovaná (na rozdiel od celého poolu).
+    void setRetainSpareTail(bool enabled) {
+        retainTail_ = enabled;
+        if (!enabled && !pool_) {
+            delete spare_[1];
+            spare_[1] = nullptr;
+        }
+    }
+    bool retainSpareTail() const { return retainTail_; }
+
+    // ==================== POSTUPNÝ REBUILD ====================
+
+    // Zapne/vypne postupný (deamortizovaný) rebuild.
+    // Keď je zapnutý, push_back/shrink na prahu N == B^r resp. N == (B/4)^r nespraví
+    // O(N) rebuild naraz: stará geometria ostane žiť vedľa novej a každá ďalšia
+    // operácia presunie do novej geometrie najviac B prvkov (aj z veľkého bloku
+    // po kusoch), kým sa stará nevyprázdni. Do ďalšieho prahu zostáva aspoň N/2
+    // operácií a B >= 4, takže migrácia skončí včas.
+    // Vypnutie počas prebiehajúceho rebuildu ho najprv dokončí.
+    void setIncrementalRebuild(bool enabled);
+    bool incrementalRebuild() const { return incremental_; }
+
+    // Prebieha práve postupný rebuild? (časť prvkov je ešte v starej geometrii)
+    bool rebuildInProgress() const { return old_ != nullptr; }
+
     // ==================== OPERÁTORY ====================
 
     // arr[5] = 10; - funguje rovnako, ako get/set
+    // S -DRARRAY_NO_BOUNDS_CHECK sa kontrola hraníc vynechá (release buildy)
+#ifdef RARRAY_NO_BOUNDS_CHECK
+    T& operator[](size_t index) { return get_unchecked(index); }
+    const T& operator[](size_t index) const { return get_unchecked(index); }
+#else
     T& operator[](size_t index) { return get(index); }
     const T& operator[](size_t index) const { return get(index); }
+#endif
 
     // ==================== ITERÁTORY ====================
 
-    class Iterator {
+    // Iterátor s náhodným prístupom (spĺňa std::random_access_iterator).
+    // Drží ukazovateľ priamo do aktuálneho bloku, takže ++/-- je len posun
+    // ukazovateľa a blok sa hľadá znova (cez layout_) až na jeho hranici.
+    // Zmena štruktúry (push_back, shrink, ...) iterátory zneplatní, ako pri std::vector.
+    template<bool Const>
+    class BasicIterator {
     public:
-        Iterator(ResizableArray* arr, size_t index)
-            : arr_(arr), index_(index) {}
-
-        T& operator*() {
-            return arr_->get(index_);
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using ArrayPtr          = std::conditional_t<Const, const ResizableArray*, ResizableArray*>;
+
+        BasicIterator() = default;
+
+        BasicIterator(ArrayPtr arr, size_t index)
+            : arr_(arr), index_(index) {
+            seek();
         }
 
-        Iterator& operator++() {
-            ++index_;
+        // Iterator sa dá vždy previesť na ConstIterator
+        template<bool C = Const> requires C
+        BasicIterator(const BasicIterator<false>& other)
+            : arr_(other.arr_), index_(other.index_), cur_(other.cur_),
+              blockBegin_(other.blockBegin_), blockEnd_(other.blockEnd_) {}
+
+        reference operator*() const { return *cur_; }
+        pointer operator->() const { return cur_; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        BasicIterator& operator++() {
+            if (++index_ < blockEnd_) ++cur_;
+            else seek();
             return *this;
         }
 
-        bool operator!=(const Iterator& other) const {
-            return index_ != other.index_;
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            ++*this;
+            return tmp;
         }
 
-    private:
-        ResizableArray* arr_;
-        size_t index_;
-    };
-
-    class ConstIterator {
-    public:
-        ConstIterator(const ResizableArray* arr, size_t index)
-            : arr_(arr), index_(index) {}
+        BasicIterator& operator--() {
+            if (cur_ && index_ > blockBegin_) { --index_; --cur_; }
+            else { --index_; seek(); }
+            return *this;
+        }
 
-        const T& operator*() const {
-            return arr_->get(index_);
+        BasicIterator operator--(int) {
+            BasicIterator tmp = *this;
+            --*this;
+            return tmp;
         }
 
-        ConstIterator& operator++() {
-            ++index_;
+        BasicIterator& operator+=(difference_type n) {
+            // size_t aritmetika je modulárna, takže funguje aj pre záporné n
+            index_ += static_cast<size_t>(n);
+            if (cur_ && index_ >= blockBegin_ && index_ < blockEnd_) cur_ += n;
+            else seek();
             return *this;
         }
 
-        bool operator!=(const ConstIterator& other) const {
-            return index_ != other.index_;
+        BasicIterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) { return it += n; }
+        friend BasicIterator operator+(difference_type n, BasicIterator it) { return it += n; }
+        friend BasicIterator operator-(BasicIterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
         }
 
+        bool operator==(const BasicIterator& other) const { return index_ == other.index_; }
+        auto operator<=>(const BasicIterator& other) const { return index_ <=> other.index_; }
+
     private:
-        const ResizableArray* arr_;
-        size_t index_;
+        friend class BasicIterator<!Const>;
+
+        // Nájde blok, v ktorom leží index_, a nastaví cur_ a hranice bloku
+        // (počas postupného rebuildu môže blok patriť ešte starej geometrii)
+        void seek() {
+            if (!arr_ || index_ >= arr_->length()) {
+                cur_ = nullptr;
+                blockBegin_ = blockEnd_ = index_;
+                return;
+            }
+            ArrayPtr part = arr_;
+            size_t base = 0;
+            if (index_ >= part->N_) {
+                // za *this ide najprv rozpracovaný blok carry_, potom old_
+                base = part->N_;
+                const size_t carried = part->carryLength();
+                if (index_ - base < carried) {
+                    blockBegin_ = base;
+                    blockEnd_   = base + carried;
+                    cur_ = part->carry_->data + part->carryOff_ + (index_ - base);
+                    return;
+                }
+                base += carried;
+                part = part->old_;
+            }
+            const Layout& layout = part->layout_;
+            const size_t local = index_ - base;
+            const size_t lvl = part->levelOf(local);
+            const size_t b   = (local - layout.start[lvl]) >> layout.shift[lvl];
+            blockBegin_ = base + layout.start[lvl] + (b << layout.shift[lvl]);
+            // posledný B-blok časti je čiastočný (n0_ prvkov), za ním pokračuje ďalšia časť
+            const size_t full = blockBegin_ + layout.blockSize[lvl];
+            blockEnd_ = (full < base + part->N_ ? full : base + part->N_);
+            cur_ = part->levels_[lvl].items[b] + (index_ - blockBegin_);
+        }
+
+        ArrayPtr arr_ = nullptr;
+        size_t index_ = 0;
+        pointer cur_ = nullptr;     // prvok na pozícii index_ (nullptr mimo poľa)
+        size_t blockBegin_ = 0;     // index prvého prvku aktuálneho bloku
+        size_t blockEnd_ = 0;       // index za posledným prvkom aktuálneho bloku
     };
 
+    using Iterator      = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
     // begin / end
     Iterator begin() {
         return Iterator(this, 0);
     }
 
     Iterator end() {
-        return Iterator(this, N_);
+        return Iterator(this, length());
     }
 
     ConstIterator begin() const {
@@ -170,24 +515,153 @@ public:
     }
 
     ConstIterator end() const {
-        return ConstIterator(this, N_);
+        return ConstIterator(this, length());
     }
 
+    ConstIterator cbegin() const { return begin(); }
+    ConstIterator cend() const { return end(); }
 
+    // ==================== SEGMENTY ====================
+
+    // Súvislé kusy pamäte, z ktorých sa pole skladá, v poradí indexov:
+    // plné bloky úrovní R-1..2, potom bloky úrovne 1 (posledný má len n0_ prvkov).
+    // Hodí sa na memcpy, std::transform, checksumy alebo SIMD slučky po blokoch.
+    template<bool Const>
+    class SegmentIterator {
+    public:
+        using ElementType       = std::conditional_t<Const, const T, T>;
+        using ArrayPtr          = std::conditional_t<Const, const ResizableArray*, ResizableArray*>;
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // operator* vracia span hodnotou
+        using value_type        = std::span<ElementType>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::span<ElementType>;
+
+        SegmentIterator() = default;
+
+        // lvl == 0 znamená koniec
+        SegmentIterator(ArrayPtr arr, size_t lvl)
+            : arr_(arr), lvl_(lvl), blk_(0) {
+            if (lvl_ > 0) skipEmpty();
+        }
+
+        std::span<ElementType> operator*() const {
+            if (lvl_ == R) return {arr_->carry_->data + arr_->carryOff_, arr_->carryLength()};
+            const size_t size = (lvl_ == 1 && blk_ + 1 == arr_->n_[1])
+                ? arr_->n0_
+                : arr_->layout_.blockSize[lvl_];
+            return {arr_->levels_[lvl_].items[blk_], size};
+        }
+
+        SegmentIterator& operator++() {
+            if (lvl_ == R) {
+                // za rozpracovaným blokom pokračujú bloky starej geometrie
+                arr_ = arr_->old_;
+                lvl_ = R - 1;
+                blk_ = 0;
+            } else {
+                ++blk_;
+            }
+            skipEmpty();
+            return *this;
+        }
+
+        SegmentIterator operator++(int) {
+            SegmentIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const SegmentIterator& other) const {
+            return lvl_ == other.lvl_ && blk_ == other.blk_ && (lvl_ == 0 || arr_ == other.arr_);
+        }
+
+    private:
+        // Preskočí na ďalšiu neprázdnu úroveň, keď sa aktuálna minula.
+        // Počas postupného rebuildu po novej geometrii pokračuje rozpracovaný
+        // blok carry_ (lvl_ == R) a potom bloky starej.
+        void skipEmpty() {
+            while (true) {
+                while (lvl_ >= 1 && blk_ >= arr_->n_[lvl_]) {
+                    --lvl_;
+                    blk_ = 0;
+                }
+                if (lvl_ > 0 || !arr_->old_) break;
+                if (arr_->carryLength() > 0) {
+                    lvl_ = R;
+                    break;
+                }
+                arr_ = arr_->old_;
+                lvl_ = R - 1;
+            }
+        }
+
+        ArrayPtr arr_ = nullptr;
+        size_t lvl_ = 0;
+        size_t blk_ = 0;
+    };
+
+    template<bool Const>
+    class SegmentRange {
+    public:
+        using ArrayPtr = std::conditional_t<Const, const ResizableArray*, ResizableArray*>;
+
+        explicit SegmentRange(ArrayPtr arr) : arr_(arr) {}
+
+        SegmentIterator<Const> begin() const { return SegmentIterator<Const>(arr_, R - 1); }
+        SegmentIterator<Const> end() const { return SegmentIterator<Const>(arr_, 0); }
+
+    private:
+        ArrayPtr arr_;
+    };
+
+    // for (std::span<int> s : arr.segments()) { ... }
+    SegmentRange<false> segments() { return SegmentRange<false>(this); }
+    SegmentRange<true> segments() const { return SegmentRange<true>(this); }
+
+    // Zavolá f(std::span<T>) pre každý súvislý kus poľa v poradí indexov
+    template<typename F>
+    void for_each_segment(F f);
+
+    template<typename F>
+    void for_each_segment(F f) const;
+
+    // Prechod s krokom: f(T&) pre indexy from, from + stride, from + 2*stride, ...
+    // kým sú v [0, N). Pri stride < 0 ide pole odzadu (predvolene od N - 1, od
+    // posledného B-bloku). Postupnosť blokov je známa vopred: kým sa spracúva
+    // blok, prefetchuje sa položka tabuľky ďalšieho bloku a prvé cache line,
+    // na ktoré prechod v ďalšom bloku dopadne. stride == 0 hodí
+    // std::invalid_argument, from >= N (pri neprázdnom poli) std::out_of_range.
+    template<typename F>
+    void scan(std::ptrdiff_t stride, F f);
+    template<typename F>
+    void scan(std::ptrdiff_t stride, F f) const;
+    template<typename F>
+    void scan(size_t from, std::ptrdiff_t stride, F f);
+    template<typename F>
+    void scan(size_t from, std::ptrdiff_t stride, F f) const;
 
 //private:
     // ==================== VNÚTORNÉ ŠTRUKTÚRY ====================
 
     // Jeden blok pamäte, ktorý drží prvky
     // Bloky sú rôznych veľkostí: B, B², B³, ...
+    // Pamäť je neinicializovaná - skonštruovaných je len prvých `size` prvkov,
+    // takže T nemusí mať implicitný konštruktor a alokácia bloku nič nekonštruuje.
     struct DataBlock {
         T* data;           // Tu sú uložené prvky
         size_t capacity;   // Koľko prvkov sa sem zmestí
+        size_t size;       // Koľko prvkov (od začiatku) je naozaj skonštruovaných
+        std::pmr::memory_resource* resource; // Odkiaľ je pamäť (tam sa aj vráti)
 
-        // Vytvorí nový blok danej veľkosti
-        DataBlock(size_t cap);
+        // Vytvorí nový (prázdny) blok danej veľkosti
+        DataBlock(size_t cap, std::pmr::memory_resource* mr = std::pmr::get_default_resource());
 
-        // Zmaže blok a uvoľní pamäť
+        // Prevezme už alokovanú pamäť (napr. z namapovaného súboru) s used živými
+        // prvkami; vráti ju cez mr->deallocate ako každý iný blok
+        DataBlock(T* mem, size_t cap, size_t used, std::pmr::memory_resource* mr);
+
+        // Zničí živé prvky a uvoľní pamäť
         ~DataBlock();
 
         // Bloky sa nekopírujú, len presúvajú (kvôli výkonu)
@@ -200,15 +674,22 @@ public:
     };
 
     // Vlastná implementácia dynamického poľa (lebo nie je mozne používať std::vector)
-    // Ukladá ukazovatele na bloky
+    // Ukladá ukazovatele na bloky a vedľa nich priamo ukazovatele na ich prvky
+    // (items[j] == data[j]->data), aby get() nemusel čítať hlavičku bloku.
+    // Obe tabuľky ležia v jednej alokácii; bloky sa preto menia len cez metódy,
+    // nie zápisom do data[] (ten by items nezosynchronizoval).
     template<typename BlockType>
     struct DynamicArray {
+        using Item = decltype(std::declval<BlockType&>().data);
+
         BlockType** data;   // Pole ukazovateľov
+        Item* items;        // Ukazovatele na prvky blokov (paralelne s data)
         size_t size;        // Koľko blokov tu máme
         size_t capacity;    // Koľko blokov sa zmestí
+        std::pmr::memory_resource* resource; // Odkiaľ sú tabuľky
 
         // Začne prázdne
-        DynamicArray();
+        explicit DynamicArray(std::pmr::memory_resource* mr = std::pmr::get_default_resource());
 
         // Uprace všetky bloky
         ~DynamicArray();
@@ -216,12 +697,21 @@ public:
         // Zabezpečí, že sa zmestí aspoň newCap blokov
         void reserve(size_t newCap);
 
+        // Zmenší kapacitu na aktuálny počet blokov
+        void shrink_to_fit();
+
         // Pridá blok na koniec
         void push_back(BlockType* block);
 
         // Odstráni a zmaže posledný blok
         void pop_back();
 
+        // Odstráni posledný blok bez zmazania a vráti ho volajúcemu
+        BlockType* take_back();
+
+        // Odstráni prvých count blokov bez zmazania (zvyšok sa posunie dopredu)
+        void detach_front(size_t count);
+
         // Odstráni bloky od start po end (nie vrátane end)
         void erase(size_t start, size_t end);
 
@@ -231,7 +721,10 @@ public:
         // Prístup k blokom
         BlockType* operator[](size_t index);
         const BlockType* operator[](size_t index) const;
-        BlockType*& at(size_t index);  // S kontrolou hraníc
+        BlockType*& at(size_t index);  // S kontrolou hraníc (len na čítanie)
+
+        // Vymení obsah s iným poľom (bez alokácie)
+        void swap(DynamicArray& other) noexcept;
 
         // Nekopíruje sa
         DynamicArray(const DynamicArray&) = delete;
@@ -240,6 +733,27 @@ public:
 
     // ==================== VNÚTORNÁ LOGIKA ====================
 
+    // Zdroj pre nové bloky úrovne lvl
+    std::pmr::memory_resource* blockResource(size_t lvl) const {
+        return (lvl >= largeFrom_ ? largeResource_ : resource_);
+    }
+
+    // Prázdny blok úrovne lvl (veľkosti B^lvl): z poolu, inak nový z blockResource(lvl)
+    DataBlock* acquireBlock(size_t lvl);
+
+    // Zničí živé prvky bloku úrovne lvl a vráti ho do poolu, alebo ho zmaže
+    void releaseBlock(size_t lvl, DataBlock* block);
+
+    // Zmaže všetky odložené bloky (napr. keď sa mení B a veľkosti už nesedia)
+    void releaseSpares();
+
+    // Zmaže blok, ktorý štruktúra už nepoužíva, alebo ho (keď je nastavené
+    // retired_) len odovzdá - čitatelia ConcurrentRArray ho môžu ešte čítať
+    void disposeBlock(DataBlock* block) {
+        if (retired_) retired_->push_back(block);
+        else delete block;
+    }
+
     // Keď sa naplní úroveň, skombinuj B blokov do jedného väčšieho
     // Toto je kľúčová operácia - implementuje "redundant base-B counter"
     void combineBlocks();
@@ -248,8 +762,127 @@ public:
     // Volá sa keď už nie sú malé bloky a potrebujeme ich
     void splitBlocks();
 
+    // g(data, len) pre bloky v poradí indexov (Reverse: odzadu), vrátane old_
+    template<bool Reverse, typename Self, typename G>
+    static void walkBlocks(Self& self, G& g);
+
+    // Spoločná implementácia scan() pre const aj nekonštantné pole
+    template<typename Self, typename F>
+    static void scanImpl(Self& self, size_t from, std::ptrdiff_t stride, F& f);
+
+    // Koľko cache line ďalšieho bloku scan() prefetchuje
+    static constexpr size_t SCAN_PREFETCH_LINES = 4;
+
+    // Je pri ďalšom push_back potrebný rebuild alebo combineBlocks?
+    // (vtedy sa existujúce prvky presúvajú a referencie do poľa prestanú platiť)
+    bool backNeedsRestructure() const;
+
+    // Pripraví miesto na konci pre nový prvok: rebuild, combineBlocks, nový B-blok
+    void prepareBack();
+
+    // Zapíše nový prvok na pripravené miesto na konci
+    template<typename... Args>
+    T& placeBack(Args&&... args);
+
+    // Presunie count prvkov zo src do neinicializovaného dst a zničí ich v src
+    // (bloky sa nikdy neprekrývajú). Pre triviálne kopírovateľné T je to memcpy.
+    static void relocateElements(T* dst, T* src, size_t count);
+
+    // Do prázdnej štruktúry (s nastaveným B_) rozloží count prvkov priamo po blokoch.
+    // fill(DataBlock& block, size_t n) musí skonštruovať ďalších n prvkov od block.size
+    // a priebežne zvyšovať block.size (aby sa pri výnimke zničili len živé prvky).
+    template<typename Fill>
+    void fillLevels(size_t count, Fill fill);
+
+    // Postupný rebuild: súčasná štruktúra sa presunie do old_ a *this začne
+    // prázdna s novým B; prvky z old_ sa potom presúvajú po blokoch na koniec *this
+    void beginMigration(size_t newB);
+
+    // Presunie najviac B_ prvkov z čela old_ (cez carry_) na koniec
+    // *this; keď sú old_ aj carry_ prázdne, zruší ich
+    void migrateStep();
+
+    // Počet živých prvkov v carry_
+    size_t carryLength() const { return carry_ ? carry_->size - carryOff_ : 0; }
+
+    // Prvok na pozícii j za N_ počas postupného rebuildu (v carry_ alebo old_)
+    T& migratingItem(size_t j) const {
+        const size_t carried = carryLength();
+        return j < carried ? carry_->data[carryOff_ + j] : old_->get_unchecked(j - carried);
+    }
+
+    // Zničí živé prvky carry_ a zmaže ho
+    void dropCarry();
+
+    // Dokončí prebiehajúci postupný rebuild naraz
+    void finishMigration();
+
+    // Vyberie prvý blok (v poradí indexov) zo štruktúry bez jeho zmazania
+    DataBlock* takeFrontBlock();
+
+    // Dá sa count prvkov pridať hromadne? Počas postupného rebuildu (alebo ak by
+    // sa ním mal spustiť) sa pridáva po prvkoch, aby ostala zachovaná O(1) cena operácie.
+    bool canAppendInBulk(size_t count) const;
+
+    // Hromadné pridanie count prvkov; copy(T* dst, size_t n) skonštruuje ďalších n
+    // prvkov zdroja do neinicializovaného dst (všetky alebo žiadny).
+    template<typename Copy>
+    void appendCounted(size_t count, Copy copy);
+
+    // Pridá prvky zo segmentu, ktoré spĺňajú pred (jadro filter())
+    template<typename Predicate>
+    void appendFiltered(std::span<const T> segment, Predicate& pred);
+
+    // Pridá count prvkov zo segmentov počnúc segmentom seg (od pozície off v ňom);
+    // relocate(src, n, dst) ich skonštruuje v cieli (kópia alebo presun)
+    template<typename SegIt, typename Relocate>
+    void appendSegments(SegIt seg, size_t off, size_t count, Relocate relocate);
+
+    // Presunie všetky prvky other na koniec tohto poľa (other ostane prázdne)
+    void appendMoved(ResizableArray&& other);
+
+    // Koľko vlákien sa oplatí na count prvkov pri danej politike
+    template<typename Policy>
+    static size_t workerCount(const Policy& policy, size_t count);
+
+    // Úseky segmentov (v poradí), ktoré pokrývajú prvky [from, to) zo spans
+    template<typename Elem>
+    static std::vector<std::span<Elem>>
+    sliceSpans(const std::vector<std::span<Elem>>& spans, size_t from, size_t to);
+
+    // Spustí job(w) pre w < workers (posledný beží na volajúcom vlákne),
+    // počká na všetky a prípadnú prvú výnimku hodí ďalej
+    template<typename Job>
+    static void runWorkers(size_t workers, Job job);
+
+    // Každé vlákno spracuje svoj kus src cez work(čiastkový výsledok, úsek),
+    // čiastkové výsledky sa potom v poradí presunú do jedného
+    template<typename Out, typename Elem, typename Work>
+    static Out stitchParallel(const std::vector<std::span<Elem>>& src, size_t total,
+                              size_t workers, Work work);
+
+    // Výsledok so známou dĺžkou total: najprv sa vyrobí jeho tvar
+    // (neinicializované miesta) a vlákna doň priamo zapíšu fill(out, in, n).
+    // Len pre triviálne kopírovateľné a zničiteľné U.
+    template<typename U, typename Elem, typename Fill>
+    static ResizableArray<U, R> fillParallel(const std::vector<std::span<Elem>>& src, size_t total,
+                                             size_t workers, Fill fill);
+
+    // Spoločné jadro rebuild() a append(): nová geometria s aspoň newB, do ktorej
+    // sa najprv presunú staré bloky a za ne fillExtra(block, n) doplní extra nových
+    // prvkov (rovnaký kontrakt ako fill vo fillLevels).
+    template<typename Fill>
+    void relayout(size_t newB, size_t extra, Fill fillExtra);
+
+    // Ak na konci ostal prázdny B-blok (nevydarené pridanie), odstráni ho
+    void dropEmptyTail();
+
     // Keď pole príliš narástlo alebo sa zmenšilo, musíme prebudovať všetko
     // s novým parametrom B (zdvojnásobí sa alebo zmenší na polovicu)
+    // newB musí byť mocnina 2 (>= 2), inak hodí std::invalid_argument
+    // Ak by sa prvky do newB^R nezmestili, B sa zväčší na najbližšiu vhodnú mocninu 2
+    // Staré bloky sa presúvajú do novej geometrie postupne (bez bufferu celého poľa);
+    // ak presun prvku hodí výnimku, pole ostane prázdne.
     void rebuild(size_t newB);
 
     // Vypočíta base^exp (napr. B^3)
@@ -260,6 +893,23 @@ public:
     // Vráti (úroveň, pozícia_v_tej_úrovni)
     std::pair<size_t, size_t> locateItem(size_t index) const;
 
+    // Úroveň, do ktorej patrí index (index < N_), podľa layout_.start
+    // start[] s úrovňou klesá (start[R-1] == 0), takže úroveň je 1 + počet úrovní
+    // 1..R-2, ktoré začínajú až za indexom. Fold sa pre dané R rozvinie na R-2
+    // porovnaní bez cyklu a skokov (pre R = 2 je to rovno 1).
+    size_t levelOf(size_t index) const {
+        return levelOfImpl(index, std::make_index_sequence<LEVELS - 1>{});
+    }
+
+    template<size_t... I>
+    size_t levelOfImpl([[maybe_unused]] size_t index, std::index_sequence<I...>) const {
+        return (size_t{1} + ... + static_cast<size_t>(index < layout_.start[I + 1]));
+    }
+
+    // Prepočíta layout_ z B_ a n_ (volá sa len keď sa mení geometria:
+    // combineBlocks, splitBlocks, rebuild a (re)inicializácia)
+    void updateLayout();
+
     // Nastaví pole úrovní a počítadlá
     void initializeLevels();
 
@@ -273,27 +923,162 @@ public:
 
     static constexpr size_t r_ = R;  // Parameter r (2, 3, 4, ...) - nastavuje trade-off
 
-    size_t N_;   // Koľko prvkov je celkovo v poli
+    // Predpočítaná geometria pre rýchle get() bez power()
+    // blockSize[i] = B^i
+    // shift[i]     = log2(B^i) - B je vždy mocnina 2, takže delenie je posun a modulo maska
+    // start[i]     = index prvého prvku úrovne i (úrovne idú v poradí R-1, ..., 2, 1)
+    // Úroveň 1 je posledná, takže push_back/shrink v nej layout nemenia.
+    // growAt       = B^R - pri takom N potrebuje push_back rebuild(2B)
+    // shrinkAt     = (B/4)^R - pri takom N robí shrink rebuild(B/2) (max. hodnota, ak B < 8)
+    struct Layout {
+        size_t blockSize[R];
+        size_t shift[R];
+        size_t start[R];
+        size_t growAt;
+        size_t shrinkAt;
+    };
+
+    // Všetko, čo čítajú get(), push_back() a shrink(), leží priamo v objekte
+    // a súvislo od hranice cache line: počty, geometria aj tabuľky úrovní.
+    // Prístup k prvku je tak len items[] úrovne -> prvok (dve závislé čítania).
+
+    alignas(64) size_t N_;   // Koľko prvkov je celkovo v poli
     size_t B_;   // Veľkosť základného bloku - mení sa keď pole rastie/klesá
 
+    // Koľko prvkov je v poslednom (čiastočne zaplnenom) bloku úrovne 1
+    size_t n0_;
+
+    Layout layout_;
+
+    // Koľko blokov je na každej úrovni
+    size_t n_[R];
+
     // Pole úrovní - každá úroveň má bloky rôznych veľkostí
     // úroveň 1: bloky veľkosti B
     // úroveň 2: bloky veľkosti B²
     // úroveň 3: bloky veľkosti B³
     // atď.
-    DynamicArray<DataBlock>* levels_;
-
-    // Koľko blokov je na každej úrovni
-    size_t* n_;
-
-    // Koľko prvkov je v poslednom (čiastočne zaplnenom) bloku úrovne 1
-    size_t n0_;
+    DynamicArray<DataBlock> levels_[R];
+
+    // Postupný rebuild: stará geometria so zvyšnými (zadnými) prvkami poľa.
+    // Prvky *this majú indexy [0, N_), prvky old_ nasledujú za nimi.
+    ResizableArray* old_ = nullptr;
+    // Predný blok vybraný z old_, ktorý sa presúva po kusoch: živé sú prvky
+    // [carryOff_, carry_->size) a v poradí indexov ležia medzi *this a old_
+    DataBlock* carry_ = nullptr;
+    size_t carryOff_ = 0;
+    bool incremental_ = false;  // je zapnutý postupný rebuild?
+    bool retiring_ = false;     // táto štruktúra je old_ inej - žiadne vlastné rebuildy
+
+    // Odkiaľ sa alokujú bloky a polia blokov
+    std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+    std::pmr::memory_resource* largeResource_ = nullptr; // bloky úrovní >= largeFrom_
+    size_t largeFrom_ = R;                               // R = vypnuté
+
+    // Pool: spare_[i] je odložený prázdny blok veľkosti B^i (alebo nullptr)
+    DataBlock* spare_[R] = {};
+    bool pool_ = false;
+    bool retainTail_ = false;   // odkladať aspoň prázdny B-blok z konca (spare_[1])?
+
+    // Sem idú bloky namiesto delete (nastavuje len ConcurrentRArray)
+    std::vector<DataBlock*>* retired_ = nullptr;
+
+    // Štatistiky (neprenášajú sa kópiou ani presunom)
+    size_t peakRebuildBytes_ = 0;
+#if RARRAY_INSTRUMENT
+    RArrayOpStats opCombine_;
+    RArrayOpStats opSplit_;
+    RArrayOpStats opRebuild_;
+
+    // Zapíše trvanie rozsahu (aj pri výnimke) do danej štatistiky
+    struct OpTimer {
+        RArrayOpStats& stats;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ~OpTimer() {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            stats.record(static_cast<uint64_t>(ns));
+        }
+    };
+#define RARRAY_TIME_OP(stat) OpTimer rarrayOpTimer_{stat}
+#else
+#define RARRAY_TIME_OP(stat) ((void)0)
+#endif
 
     // ==================== KONŠTANTY ====================
 
     // Začíname s B=4 (pre malé pole)
-    // Keď pole rastie, B sa zdvojnásobuje
+    // Keď pole rastie, B sa zdvojnásobuje - B zostáva vždy mocninou 2
     static constexpr size_t INITIAL_B = 4;
+    static_assert((INITIAL_B & (INITIAL_B - 1)) == 0, "INITIAL_B must be a power of two");
+    static_assert(R >= 2, "ResizableArray needs at least one level (R >= 2)");
+
+    // Počet používaných úrovní (1..R-1); úroveň 0 je prázdna
+    static constexpr size_t LEVELS = R - 1;
+};
+
+// Nevlastniaci pohľad na súvislý úsek ResizableArray (len na čítanie).
+// Indexuje priamo cez bloky rodiča, nič sa nekopíruje. Zneplatní ho každá
+// zmena štruktúry rodiča (push_back, shrink, rebuild, ...).
+template<typename T, size_t R>
+class RArrayView {
+public:
+    using value_type     = T;
+    using const_iterator = typename ResizableArray<T, R>::ConstIterator;
+
+    RArrayView(const ResizableArray<T, R>& arr, size_t from, size_t to)
+        : arr_(&arr), from_(from), size_(to - from) {
+        if (from > to || to > arr.length()) {
+            throw std::out_of_range("Invalid view range");
+        }
+    }
+
+    size_t length() const { return size_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const T& operator[](size_t index) const { return arr_->get_unchecked(from_ + index); }
+    const T& get(size_t index) const {
+        if (index >= size_) throw std::out_of_range("view get: index out of range");
+        return arr_->get_unchecked(from_ + index);
+    }
+
+    const_iterator begin() const { return const_iterator(arr_, from_); }
+    const_iterator end() const { return const_iterator(arr_, from_ + size_); }
+
+    // Pohľad na [from, to) v rámci tohto pohľadu
+    RArrayView subview(size_t from, size_t to) const {
+        if (from > to || to > size_) {
+            throw std::out_of_range("Invalid view range");
+        }
+        return RArrayView(*arr_, from_ + from, from_ + to);
+    }
+
+    // f(std::span<const T>) pre súvislé kusy pohľadu v poradí
+    template<typename F>
+    void for_each_segment(F f) const {
+        size_t segStart = 0;
+        const size_t to = from_ + size_;
+        for (std::span<const T> segment : arr_->segments()) {
+            if (segStart >= to) break;
+            const size_t segEnd = segStart + segment.size();
+            if (segEnd > from_) {
+                const size_t lo = (from_ > segStart ? from_ - segStart : 0);
+                const size_t hi = (to < segEnd ? to - segStart : segment.size());
+                f(segment.subspan(lo, hi - lo));
+            }
+            segStart = segEnd;
+        }
+    }
+
+    // Vlastná kópia pohľadu
+    ResizableArray<T, R> to_rarray() const { return arr_->sub_rarray(from_, from_ + size_); }
+
+private:
+    const ResizableArray<T, R>* arr_;
+    size_t from_;
+    size_t size_;
 };
+
 #include "rarray_impl.tpp"
 #endif // PROJEKT_RARRAY_H
\ No newline at end of file
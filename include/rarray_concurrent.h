@@ -0,0 +1,280 @@
+#ifndef PROJEKT_RARRAY_CONCURRENT_H
+#define PROJEKT_RARRAY_CONCURRENT_H
+
+// Jeden zapisovateľ, veľa čitateľov bez zámkov nad ResizableArray
+//
+// Zapisovateľ po každej operácii, ktorá zmení geometriu (nový/uvoľnený blok,
+// combineBlocks, splitBlocks, rebuild), zverejní nemennú snímku: kópiu
+// tabuliek ukazovateľov na bloky a layoutu. Inak len posunie dĺžku aktuálnej
+// snímky. Čitateľ si snímku "pripne" (epocha), indexuje cez ňu bez zámkov
+// a bloky, ktoré štruktúra medzitým zahodila, sa uvoľnia až keď žiaden
+// pripnutý čitateľ nemôže držať snímku, ktorá ich ešte obsahuje.
+//
+// Obmedzenia:
+//  - T musí byť triviálne kopírovateľné (presun bloku je memcpy a staré bloky
+//    ostanú čitateľné, kým sa neuvoľnia);
+//  - čitateľ, ktorý číta prvok, čo zapisovateľ medzitým odobral (shrink)
+//    a prepísal novým push_back, číta pretekom - pri raste len cez push_back
+//    (typický ingest) sa to nestane;
+//  - postupný rebuild a pool blokov sa v tomto režime nepoužívajú;
+//  - pripnutie čitateľa navždy zastaví uvoľňovanie starých blokov.
+
+#include "rarray.h"
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+template<typename T, size_t R = 3>
+class ConcurrentRArray {
+    static_assert(std::is_trivially_copyable_v<T>, "ConcurrentRArray needs a trivially copyable T");
+
+    using Array     = ResizableArray<T, R>;
+    using DataBlock = typename Array::DataBlock;
+
+    // Nemenná geometria v jednom okamihu (mení sa len dĺžka pri zápise do posledného bloku)
+    struct Snapshot {
+        std::atomic<size_t> length{0};
+        size_t start[R] = {};
+        size_t shift[R] = {};
+        size_t mask[R] = {};
+        T* const* level[R] = {};
+        std::vector<T*> items; // tabuľky blokov všetkých úrovní za sebou
+
+        const T& at(size_t index) const {
+            // rovnaké hľadanie úrovne ako ResizableArray::levelOf
+            size_t lvl = 1;
+            for (size_t j = 1; j + 1 < R; ++j) lvl += static_cast<size_t>(index < start[j]);
+            const size_t x = index - start[lvl];
+            return level[lvl][x >> shift[lvl]][x & mask[lvl]];
+        }
+    };
+
+    // Čo čaká na uvoľnenie: snímka a bloky zahodené v tej istej epoche
+    struct Retired {
+        uint64_t epoch;
+        Snapshot* snapshot;
+        std::vector<DataBlock*> blocks;
+    };
+
+    // Stav jedného čitateľa; epoch == 0 znamená "nič nemá pripnuté".
+    // depth je počet živých ReadGuard čitateľa (mení ho len jeho vlákno): vnorené
+    // pripnutie ponechá epochu vonkajšieho, tá chráni aj každú novšiu snímku.
+    struct alignas(64) Slot {
+        std::atomic<bool> used{false};
+        std::atomic<uint64_t> epoch{0};
+        size_t depth = 0;
+    };
+
+public:
+    // Pripnutá snímka: kým existuje, všetko, čo z nej čitateľ vidí, ostáva platné
+    class ReadGuard {
+    public:
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ~ReadGuard() {
+            if (--slot_->depth == 0) slot_->epoch.store(0, std::memory_order_release);
+        }
+
+        size_t length() const { return length_; }
+        bool empty() const { return length_ == 0; }
+
+        const T& operator[](size_t index) const { return snap_->at(index); }
+        const T& get(size_t index) const {
+            if (index >= length_) throw std::out_of_range("get: index out of range");
+            return snap_->at(index);
+        }
+
+        // f(std::span<const T>) pre súvislé kusy [0, length()) v poradí
+        template<typename F>
+        void for_each_segment(F f) const {
+            size_t left = length_;
+            for (size_t lvl = R - 1; lvl >= 1 && left > 0; --lvl) {
+                const size_t blockSize = snap_->mask[lvl] + 1;
+                const size_t first = snap_->start[lvl];
+                const size_t end = (lvl > 1 ? snap_->start[lvl - 1] : first + left);
+                for (size_t b = 0; first + b * blockSize < end && left > 0; ++b) {
+                    const size_t n = (blockSize < left ? blockSize : left);
+                    f(std::span<const T>(snap_->level[lvl][b], n));
+                    left -= n;
+                }
+            }
+        }
+
+    private:
+        friend class ConcurrentRArray;
+        ReadGuard(Slot* slot, const Snapshot* snap)
+            : slot_(slot), snap_(snap), length_(snap->length.load(std::memory_order_acquire)) {}
+
+        Slot* slot_;
+        const Snapshot* snap_;
+        size_t length_;
+    };
+
+    // Registrácia jedného čitateľa (jedno vlákno); uvoľní slot v deštruktore
+    class Reader {
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader(Reader&& other) noexcept : owner_(other.owner_), slot_(other.slot_) { other.slot_ = nullptr; }
+        ~Reader() {
+            if (slot_) slot_->used.store(false, std::memory_order_release);
+        }
+
+        // Pripne aktuálnu snímku (bez zámku, O(1)); smie sa vnárať
+        ReadGuard pin() const {
+            // Najprv ohlásiť epochu, potom čítať snímku (obe seq_cst): zapisovateľ,
+            // ktorý nás pri uvoľňovaní nevidí, už zverejnil novšiu snímku, ktorú prečítame
+            if (slot_->depth++ == 0) {
+                slot_->epoch.store(owner_->epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            }
+            return ReadGuard(slot_, owner_->current_.load(std::memory_order_seq_cst));
+        }
+
+        // Jednorazové čítania (každé si pripne snímku samo)
+        size_t length() const { return pin().length(); }
+        T get(size_t index) const { return pin().get(index); }
+
+    private:
+        friend class ConcurrentRArray;
+        Reader(const ConcurrentRArray* owner, Slot* slot) : owner_(owner), slot_(slot) {}
+
+        const ConcurrentRArray* owner_;
+        Slot* slot_;
+    };
+
+    explicit ConcurrentRArray(size_t maxReaders = 64)
+        : slots_(std::make_unique<Slot[]>(maxReaders)), maxReaders_(maxReaders) {
+        arr_.retired_ = &retiredBlocks_;
+        current_.store(makeSnapshot(), std::memory_order_release);
+    }
+
+    ConcurrentRArray(const ConcurrentRArray&) = delete;
+    ConcurrentRArray& operator=(const ConcurrentRArray&) = delete;
+
+    // Čitatelia (Reader/ReadGuard) musia skončiť skôr
+    ~ConcurrentRArray() {
+        for (Retired& r : retired_) free(r);
+        delete current_.load(std::memory_order_relaxed);
+        arr_.retired_ = nullptr;
+        for (DataBlock* block : retiredBlocks_) delete block;
+    }
+
+    // Nový čitateľ; hodí std::runtime_error, ak sú všetky sloty obsadené
+    Reader reader() const {
+        for (size_t i = 0; i < maxReaders_; ++i) {
+            bool expected = false;
+            if (slots_[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return Reader(this, &slots_[i]);
+            }
+        }
+        throw std::runtime_error("ConcurrentRArray: too many readers");
+    }
+
+    // ==================== ZAPISOVATEĽ (jedno vlákno) ====================
+
+    void push_back(const T& item) {
+        arr_.push_back(item);
+        publish();
+    }
+
+    void shrink() {
+        arr_.shrink();
+        publish();
+    }
+
+    void append(std::span<const T> items) {
+        arr_.append(items);
+        publish();
+    }
+
+    // Zapisovateľ vidí vždy najnovší stav
+    size_t length() const { return arr_.length(); }
+    const T& get(size_t index) const { return arr_.get(index); }
+
+    // Uvoľní, čo už žiaden čitateľ nemôže vidieť (volá sa aj pri každej zmene geometrie)
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        for (size_t i = 0; i < maxReaders_; ++i) {
+            const uint64_t e = slots_[i].epoch.load(std::memory_order_seq_cst);
+            if (e != 0 && e < oldest) oldest = e;
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < retired_.size(); ++i) {
+            if (retired_[i].epoch < oldest) {
+                free(retired_[i]);
+            } else {
+                if (kept != i) retired_[kept] = std::move(retired_[i]);
+                ++kept;
+            }
+        }
+        retired_.resize(kept);
+    }
+
+    // Počet snímok čakajúcich na uvoľnenie
+    size_t pendingReclaim() const { return retired_.size(); }
+
+private:
+    Snapshot* makeSnapshot() {
+        auto* snap = new Snapshot;
+        size_t offset[R] = {};
+        size_t total = 0;
+        for (size_t i = 1; i < R; ++i) {
+            offset[i] = total;
+            total += arr_.n_[i];
+        }
+        snap->items.resize(total);
+        for (size_t i = 1; i < R; ++i) {
+            snap->start[i] = arr_.layout_.start[i];
+            snap->shift[i] = arr_.layout_.shift[i];
+            snap->mask[i]  = arr_.layout_.blockSize[i] - 1;
+            for (size_t j = 0; j < arr_.n_[i]; ++j) snap->items[offset[i] + j] = arr_.levels_[i].items[j];
+            snap->level[i] = snap->items.data() + offset[i];
+        }
+        for (size_t i = 0; i < R; ++i) n_[i] = arr_.n_[i];
+        B_ = arr_.B_;
+        snap->length.store(arr_.length(), std::memory_order_relaxed);
+        return snap;
+    }
+
+    // Po operácii zapisovateľa: nová snímka, ak sa zmenila geometria, inak len dĺžka
+    void publish() {
+        bool changed = !retiredBlocks_.empty() || arr_.B_ != B_;
+        for (size_t i = 1; i < R && !changed; ++i) changed = (arr_.n_[i] != n_[i]);
+        if (!changed) {
+            current_.load(std::memory_order_relaxed)->length.store(arr_.length(), std::memory_order_release);
+            return;
+        }
+
+        Snapshot* old = current_.exchange(makeSnapshot(), std::memory_order_seq_cst);
+        // Čitateľ s epochou <= e mohol vidieť old; kto prišiel neskôr, vidí už novú
+        const uint64_t e = epoch_.fetch_add(1, std::memory_order_seq_cst);
+        retired_.push_back(Retired{e, old, std::move(retiredBlocks_)});
+        retiredBlocks_.clear();
+        reclaim();
+    }
+
+    static void free(Retired& r) {
+        delete r.snapshot;
+        r.snapshot = nullptr;
+        for (DataBlock* block : r.blocks) delete block;
+        r.blocks.clear();
+    }
+
+    Array arr_;
+    std::vector<DataBlock*> retiredBlocks_;  // zahodené od poslednej snímky
+    std::vector<Retired> retired_;
+
+    std::atomic<Snapshot*> current_{nullptr};
+    std::atomic<uint64_t> epoch_{1};
+    std::unique_ptr<Slot[]> slots_;
+    size_t maxReaders_;
+
+    // geometria poslednej zverejnenej snímky
+    size_t n_[R] = {};
+    size_t B_ = 0;
+};
+
+#endif // PROJEKT_RARRAY_CONCURRENT_H
@@ -0,0 +1,30 @@
+#ifndef PROJEKT_RARRAY_EXECUTION_H
+#define PROJEKT_RARRAY_EXECUTION_H
+
+// Štandardné politiky std::execution pre paralelné operácie ResizableArray:
+//   arr.filter(std::execution::par, pred)
+// Samostatný hlavičkový súbor, lebo <execution> v libstdc++ ťahá TBB
+// (program potom treba linkovať s -ltbb); rarray_exec::seq/par ho nepotrebujú.
+
+#include <execution>
+
+#include "rarray.h"
+
+namespace rarray_exec {
+    template<> struct policy_traits<std::execution::sequenced_policy> {
+        static constexpr bool parallel = false;
+    };
+    template<> struct policy_traits<std::execution::parallel_policy> {
+        static constexpr bool parallel = true;
+    };
+    template<> struct policy_traits<std::execution::parallel_unsequenced_policy> {
+        static constexpr bool parallel = true;
+    };
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201902L
+    template<> struct policy_traits<std::execution::unsequenced_policy> {
+        static constexpr bool parallel = false;
+    };
+#endif
+} // namespace rarray_exec
+
+#endif // PROJEKT_RARRAY_EXECUTION_H
@@ -1,9 +1,15 @@
 #pragma once
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <memory>
 #include <stdexcept>
+#include <thread>
 #include <new>
 #include <utility>
 
 #include "rarray.h"
+#include "rarray_simd.h"
 
 // ===================== DataBlock =====================
 //
@@ -12,32 +18,44 @@
 // rôznych veľkostí: B, B^2, B^3, ...
 //
 template<typename T, size_t R>
-ResizableArray<T, R>::DataBlock::DataBlock(size_t cap)
-    : data(cap ? new T[cap] : nullptr), capacity(cap) {}
+ResizableArray<T, R>::DataBlock::DataBlock(size_t cap, std::pmr::memory_resource* mr)
+    : data(cap ? static_cast<T*>(mr->allocate(cap * sizeof(T), BLOCK_ALIGN)) : nullptr),
+      capacity(cap), size(0), resource(mr) {}
+
+template<typename T, size_t R>
+ResizableArray<T, R>::DataBlock::DataBlock(T* mem, size_t cap, size_t used, std::pmr::memory_resource* mr)
+    : data(mem), capacity(cap), size(used), resource(mr) {}
 
 template<typename T, size_t R>
 ResizableArray<T, R>::DataBlock::~DataBlock() {
-    // Uvoľní dynamicky alokovanú pamäť
-    delete[] data;
+    // Zničí len skonštruované prvky a uvoľní surovú pamäť
+    std::destroy(data, data + size);
+    if (data) resource->deallocate(data, capacity * sizeof(T), BLOCK_ALIGN);
 }
 
 template<typename T, size_t R>
 ResizableArray<T, R>::DataBlock::DataBlock(DataBlock&& other) noexcept
-    : data(other.data), capacity(other.capacity) {
+    : data(other.data), capacity(other.capacity), size(other.size), resource(other.resource) {
     // "Move" – presunie ukazovateľ a vyčistí pôvodný blok
     other.data = nullptr;
     other.capacity = 0;
+    other.size = 0;
 }
 
 template<typename T, size_t R>
 typename ResizableArray<T, R>::DataBlock&
 ResizableArray<T, R>::DataBlock::operator=(DataBlock&& other) noexcept {
     if (this != &other) {
-        delete[] data; // odstráni pôvodné dáta
+        // odstráni pôvodné dáta
+        std::destroy(data, data + size);
+        if (data) resource->deallocate(data, capacity * sizeof(T), BLOCK_ALIGN);
         data = other.data;
         capacity = other.capacity;
+        size = other.size;
+        resource = other.resource;
         other.data = nullptr;
         other.capacity = 0;
+        other.size = 0;
     }
     return *this;
 }
@@ -50,38 +68,70 @@ ResizableArray<T, R>::DataBlock::operator=(DataBlock&& other) noexcept {
 //
 template<typename T, size_t R>
 template<typename BlockType>
-ResizableArray<T, R>::DynamicArray<BlockType>::DynamicArray()
-    : data(nullptr), size(0), capacity(0) {}
+ResizableArray<T, R>::DynamicArray<BlockType>::DynamicArray(std::pmr::memory_resource* mr)
+    : data(nullptr), items(nullptr), size(0), capacity(0), resource(mr) {}
 
 template<typename T, size_t R>
 template<typename BlockType>
 ResizableArray<T, R>::DynamicArray<BlockType>::~DynamicArray() {
     // Vyčistí všetky bloky a uvoľní pamäť
     clear();
-    delete[] data;
+    if (data) resource->deallocate(data, capacity * (sizeof(BlockType*) + sizeof(Item)), alignof(BlockType*));
 }
 
 template<typename T, size_t R>
 template<typename BlockType>
 void ResizableArray<T, R>::DynamicArray<BlockType>::reserve(size_t newCap) {
-    // Ak je potrebné viac miesta, vytvorí nové pole ukazovateľov
+    // Ak je potrebné viac miesta, vytvorí nové tabuľky (obe v jednej alokácii)
     if (newCap <= capacity) return;
-    BlockType** newData = new BlockType*[newCap];
+    static_assert(alignof(Item) <= alignof(BlockType*));
+    auto** newData = static_cast<BlockType**>(
+        resource->allocate(newCap * (sizeof(BlockType*) + sizeof(Item)), alignof(BlockType*)));
+    auto* newItems = reinterpret_cast<Item*>(newData + newCap);
     // Dôležité: inicializuj nové sloty na nullptr, aby náhodný "trash" pointer
     // nikdy nemohol spôsobiť double-delete pri chybe/nekonzistencii.
-    for (size_t i = 0; i < newCap; ++i) newData[i] = nullptr;
-    for (size_t i = 0; i < size; ++i) newData[i] = data[i];
-    delete[] data;
+    for (size_t i = 0; i < newCap; ++i) {
+        newData[i]  = nullptr;
+        newItems[i] = nullptr;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        newData[i]  = data[i];
+        newItems[i] = items[i];
+    }
+    if (data) resource->deallocate(data, capacity * (sizeof(BlockType*) + sizeof(Item)), alignof(BlockType*));
     data = newData;
+    items = newItems;
     capacity = newCap;
 }
 
+template<typename T, size_t R>
+template<typename BlockType>
+void ResizableArray<T, R>::DynamicArray<BlockType>::shrink_to_fit() {
+    if (size == capacity) return;
+    BlockType** newData = nullptr;
+    Item* newItems = nullptr;
+    if (size) {
+        newData = static_cast<BlockType**>(
+            resource->allocate(size * (sizeof(BlockType*) + sizeof(Item)), alignof(BlockType*)));
+        newItems = reinterpret_cast<Item*>(newData + size);
+        for (size_t i = 0; i < size; ++i) {
+            newData[i]  = data[i];
+            newItems[i] = items[i];
+        }
+    }
+    if (data) resource->deallocate(data, capacity * (sizeof(BlockType*) + sizeof(Item)), alignof(BlockType*));
+    data = newData;
+    items = newItems;
+    capacity = size;
+}
+
 template<typename T, size_t R>
 template<typename BlockType>
 void ResizableArray<T, R>::DynamicArray<BlockType>::push_back(BlockType* block) {
     // Pridá nový ukazovateľ na blok na koniec
     if (size >= capacity)
         reserve(capacity ? capacity * 2 : 4);
+    items[size] = block->data;
     data[size++] = block;
 }
 
@@ -89,10 +139,34 @@ template<typename T, size_t R>
 template<typename BlockType>
 void ResizableArray<T, R>::DynamicArray<BlockType>::pop_back() {
     // Odstráni a zmaže posledný blok
+    delete take_back();
+}
+
+template<typename T, size_t R>
+template<typename BlockType>
+BlockType* ResizableArray<T, R>::DynamicArray<BlockType>::take_back() {
     if (size == 0)
         throw std::out_of_range("pop_back() on empty DynamicArray");
-    delete data[--size];
-    data[size] = nullptr; // defensive: clear dangling pointer slot
+    BlockType* block = data[--size];
+    data[size]  = nullptr; // defensive: clear dangling pointer slot
+    items[size] = nullptr;
+    return block;
+}
+
+template<typename T, size_t R>
+template<typename BlockType>
+void ResizableArray<T, R>::DynamicArray<BlockType>::detach_front(size_t count) {
+    if (count > size)
+        throw std::out_of_range("Invalid detach_front count");
+    for (size_t i = count; i < size; ++i) {
+        data[i - count]  = data[i];
+        items[i - count] = items[i];
+    }
+    for (size_t i = size - count; i < size; ++i) {
+        data[i]  = nullptr;
+        items[i] = nullptr;
+    }
+    size -= count;
 }
 
 template<typename T, size_t R>
@@ -103,12 +177,15 @@ void ResizableArray<T, R>::DynamicArray<BlockType>::erase(size_t start, size_t e
         throw std::out_of_range("Invalid erase range");
     for (size_t i = start; i < end; ++i)
         delete data[i];
-    for (size_t i = end; i < size; ++i)
-        data[start + i - end] = data[i];
+    for (size_t i = end; i < size; ++i) {
+        data[start + i - end]  = data[i];
+        items[start + i - end] = items[i];
+    }
     // Vymaž "tail" sloty, aby tam nezostali duplicitné/dangling pointers
     const size_t removed = (end - start);
     for (size_t i = size - removed; i < size; ++i) {
-        data[i] = nullptr;
+        data[i]  = nullptr;
+        items[i] = nullptr;
     }
     size -= removed;
 }
@@ -119,7 +196,8 @@ void ResizableArray<T, R>::DynamicArray<BlockType>::clear() {
     // Odstráni všetky bloky a nastaví size = 0
     for (size_t i = 0; i < size; ++i) {
         delete data[i];
-        data[i] = nullptr;
+        data[i]  = nullptr;
+        items[i] = nullptr;
     }
     size = 0;
 }
@@ -146,13 +224,30 @@ BlockType*& ResizableArray<T, R>::DynamicArray<BlockType>::at(size_t index) {
     return data[index];
 }
 
+template<typename T, size_t R>
+template<typename BlockType>
+void ResizableArray<T, R>::DynamicArray<BlockType>::swap(DynamicArray& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(items, other.items);
+    std::swap(size, other.size);
+    std::swap(capacity, other.capacity);
+    std::swap(resource, other.resource);
+}
+
 
 // ===============================================
 // ResizableArray – constructor
 // ===============================================
 template<typename T, size_t R>
 ResizableArray<T, R>::ResizableArray()
-    : N_(0), B_(INITIAL_B), levels_(nullptr), n_(nullptr), n0_(0)
+    : N_(0), B_(INITIAL_B), n0_(0)
+{
+    initializeLevels();
+}
+
+template<typename T, size_t R>
+ResizableArray<T, R>::ResizableArray(std::pmr::memory_resource* resource)
+    : N_(0), B_(INITIAL_B), n0_(0), resource_(resource)
 {
     initializeLevels();
 }
@@ -163,23 +258,24 @@ ResizableArray<T, R>::ResizableArray()
 template<typename T, size_t R>
 ResizableArray<T, R>::~ResizableArray() {
     cleanupLevels();
-    delete[] levels_;
-    delete[] n_;
-    levels_ = nullptr;
-    n_ = nullptr;
+    releaseSpares();
 }
 
 template<typename T, size_t R>
 void ResizableArray<T, R>::initializeLevels() {
     // Pozn.: levels_[0] je síce "nepoužitý" v algoritme, ale pre bezpečnosť
     // ho vždy držíme v konzistentnom stave (aby sa tam nikdy nehromadili bloky).
-    if (!levels_) levels_ = new DynamicArray<DataBlock>[R];
-    if (!n_)      n_      = new size_t[R];
+    dropCarry(); // prípadný rozpracovaný postupný rebuild sa zahodí
+    delete old_;
+    old_ = nullptr;
+    releaseSpares(); // B sa mohlo zmeniť, odložené bloky by nemali správnu veľkosť
 
     for (size_t i = 0; i < R; ++i) {
         n_[i] = 0;
         // Vycisti existujúce bloky (ak nejaké boli).
         levels_[i].clear();
+        // Prázdne (napr. práve odovzdané) tabuľky sa budú alokovať z nášho zdroja
+        if (levels_[i].capacity == 0) levels_[i].resource = resource_;
         // Rezervujeme len pre reálne používané úrovne 1..R-1.
         if (i > 0) {
             levels_[i].reserve(2 * B_);
@@ -188,15 +284,14 @@ void ResizableArray<T, R>::initializeLevels() {
 
     N_  = 0;
     n0_ = 0;
+    updateLayout();
 }
 
 template<typename T, size_t R>
 void ResizableArray<T, R>::cleanupLevels() {
-    if (!levels_ || !n_) {
-        N_ = 0;
-        n0_ = 0;
-        return;
-    }
+    dropCarry();
+    delete old_;
+    old_ = nullptr;
 
     // Vycisti VŠETKY úrovne, vrátane úrovne 0 (defensive).
     for (size_t i = 0; i < R; ++i) {
@@ -205,6 +300,29 @@ void ResizableArray<T, R>::cleanupLevels() {
     }
     N_  = 0;
     n0_ = 0;
+    updateLayout();
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::updateLayout() {
+    const size_t logB = static_cast<size_t>(std::countr_zero(B_));
+    for (size_t i = 0; i < R; ++i) {
+        layout_.shift[i]     = i * logB;
+        layout_.blockSize[i] = size_t{1} << layout_.shift[i];
+    }
+
+    // Úrovne R-1..1 ležia v poradí za sebou, takže start[] je prefixový súčet.
+    size_t offset = 0;
+    for (size_t lvl = LEVELS; lvl >= 1; --lvl) {
+        layout_.start[lvl] = offset;
+        offset += n_[lvl] * layout_.blockSize[lvl];
+    }
+    layout_.start[0] = offset; // úroveň 0 sa nepoužíva
+
+    // Prahy rebuildu, aby push_back/shrink nepočítali power() pri každej operácii
+    constexpr size_t never = std::numeric_limits<size_t>::max();
+    layout_.growAt   = (R * logB < 64 ? size_t{1} << (R * logB) : never);
+    layout_.shrinkAt = (B_ >= 8 ? size_t{1} << (R * (logB - 2)) : never);
 }
 
 
@@ -233,206 +351,445 @@ std::pair<size_t, size_t> ResizableArray<T, R>::locateItem(size_t index) const {
 
     // locateItem musí reflektovať rovnaké poradie, aké používa get():
     // najprv úrovne R-1..2 ("väčšie" bloky), potom úroveň 1 (B-bloky).
-    size_t remaining = index;
+    const size_t lvl = levelOf(index);
 
-    for (size_t lvl = R - 1; lvl >= 2; --lvl) {
-        const size_t blockSize  = power(B_, lvl); // B^lvl
-        const size_t levelItems = n_[lvl] * blockSize;
-        if (remaining < levelItems) {
-            // offset v rámci spojenia blokov na tejto úrovni
-            return {lvl, remaining};
-        }
-        remaining -= levelItems;
-        if (lvl == 2) break; // underflow guard
+    // offset v rámci spojenia blokov na tejto úrovni
+    return {lvl, index - layout_.start[lvl]};
+}
+
+template<typename T, size_t R>
+typename ResizableArray<T, R>::DataBlock* ResizableArray<T, R>::acquireBlock(size_t lvl) {
+    if (DataBlock* block = spare_[lvl]) {
+        spare_[lvl] = nullptr;
+        return block;
     }
+    return new DataBlock(layout_.blockSize[lvl], blockResource(lvl));
+}
 
-    // Zvyšok patrí do úrovne 1.
-    return {1u, remaining};
+template<typename T, size_t R>
+void ResizableArray<T, R>::releaseBlock(size_t lvl, DataBlock* block) {
+    std::destroy(block->data, block->data + block->size);
+    block->size = 0;
+    if ((pool_ || (retainTail_ && lvl == 1)) && !spare_[lvl]) {
+        spare_[lvl] = block;
+        return;
+    }
+    disposeBlock(block);
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::releaseSpares() {
+    for (size_t i = 0; i < R; ++i) {
+        delete spare_[i];
+        spare_[i] = nullptr;
+    }
 }
 
 template<typename T, size_t R>
 void ResizableArray<T, R>::combineBlocks() {
+    RARRAY_TIME_OP(opCombine_);
     // k = min{i in [r-1] | n_i < 2B}, tu i=1..R-1
     size_t k = 0;
-    for (size_t i = 1; i < R; ++i) {
+    for (size_t i = 1; i <= LEVELS; ++i) {
         if (n_[i] < 2 * B_) { k = i; break; }
     }
     if (k == 0) throw std::runtime_error("combineBlocks: no k found");
 
+    // Nové bloky sa zaobstarajú vopred: ak alokácia zlyhá, pole ostane nezmenené
+    DataBlock* bigs[R] = {};
+    try {
+        for (size_t i = k - 1; i >= 1; --i) bigs[i] = acquireBlock(i + 1);
+    } catch (...) {
+        for (DataBlock* block : bigs) delete block;
+        throw;
+    }
+
     // for i = k-1 down to 1
     for (size_t i = k - 1; i >= 1; --i) {
-        const size_t smallSize = power(B_, i);     // B^i
-        const size_t bigSize   = power(B_, i + 1); // B^(i+1)
+        const size_t smallSize = layout_.blockSize[i];     // B^i
+        const size_t bigSize   = layout_.blockSize[i + 1]; // B^(i+1)
 
-        auto* big = new DataBlock(bigSize);
+        DataBlock* big = bigs[i];
 
         // skopíruj prvých B blokov A[i][0..B-1] do big (v poradí)
         for (size_t j = 0; j < B_; ++j) {
             DataBlock* src = levels_[i].at(j);
-            for (size_t p = 0; p < smallSize; ++p) {
-                big->data[j * smallSize + p] = src->data[p];
-            }
-            // dealokuj A[i][j]
-            delete src;
-        }
-
-        // shift: A[i][j] = A[i][j+B] pre j=0..B-1
-        for (size_t j = 0; j < B_; ++j) {
-            levels_[i].at(j) = levels_[i].at(j + B_);
-            levels_[i].at(j + B_) = nullptr; // aby clear() neskôr nič nedvoj-zmazal
+            relocateElements(big->data + j * smallSize, src->data, smallSize);
+            src->size = 0;
+            // dealokuj A[i][j] (alebo ho odlož do poolu)
+            releaseBlock(i, src);
         }
+        big->size = bigSize;
 
-        // n_i = B, a veľkosť containeru nastav na B
+        // shift: A[i][j] = A[i][j+B] pre j=0..B-1 (uvoľnené bloky sa už nezmažú)
+        levels_[i].detach_front(B_);
         n_[i] = B_;
-        levels_[i].size = B_; // (ak size je public, ako v tvojich testoch)
 
         // A[i+1][n_{i+1}] = big; n_{i+1}++
         levels_[i + 1].push_back(big);
         n_[i + 1] += 1;
-
-        if (i == 1) break; // size_t underflow ochrana
     }
+
+    updateLayout();
 }
 
 template<typename T, size_t R>
 void ResizableArray<T, R>::splitBlocks() {
+    RARRAY_TIME_OP(opSplit_);
     // Implementácia podľa PDF (Figure 5):
     // nájdi najmenšie k >= 2 s n_k > 0 a rozbi jeden blok veľkosti B^k na:
     //  - (B-1) blokov na každej medz úrovni (k-1..2)
     //  - B blokov na úrovni 1
     size_t k = 0;
-    for (size_t i = 2; i < R; ++i) {
+    for (size_t i = 2; i <= LEVELS; ++i) {
         if (n_[i] > 0) { k = i; break; }
     }
     if (k == 0) throw std::runtime_error("splitBlocks: nothing to split");
 
+    // Big sa rozpadne na B-1 blokov na každej úrovni k-1..2 a B blokov na úrovni 1
+    // (spolu presne B^k prvkov). Všetky sa zaobstarajú vopred, takže pri zlyhanej
+    // alokácii ostane pole nezmenené (nevrátené bloky zmaže destruktor pieces).
+    DynamicArray<DataBlock> pieces[R];
+    for (size_t i = k - 1; i >= 1; --i) {
+        const size_t count = (i == 1 ? B_ : B_ - 1);
+        pieces[i].reserve(count);
+        for (size_t j = 0; j < count; ++j) pieces[i].push_back(acquireBlock(i));
+    }
+
     // Vyberieme posledný (najnovší) veľký blok z úrovne k.
     // "pop" posledného pointera z levels_[k] bez delete (blok budeme splitovať)
-    DataBlock*& slotK = levels_[k].at(n_[k] - 1);
-    DataBlock* big = slotK;
-    slotK = nullptr;
-    levels_[k].size--;
+    DataBlock* big = levels_[k].take_back();
     n_[k]--;
 
-    // Postupne delíme "big" smerom nadol.
+    // Prvky big idú v poradí do blokov úrovní k-1, ..., 1
+    size_t offset = 0;
     for (size_t i = k - 1; i >= 1; --i) {
-        const size_t smallSize = power(B_, i);
+        const size_t smallSize = layout_.blockSize[i];
+        const size_t count = pieces[i].size;
+        for (size_t j = 0; j < count; ++j) {
+            DataBlock* piece = pieces[i][j];
+            relocateElements(piece->data, big->data + offset, smallSize);
+            piece->size = smallSize;
+            offset += smallSize;
+            levels_[i].push_back(piece);
+            n_[i] += 1;
+        }
+        pieces[i].detach_front(count);
+    }
+    big->size = 0;
+    releaseBlock(k, big);
 
-        // Vytvor B menších blokov (B_ je runtime, nechceme VLA).
-        DataBlock** tmp = new DataBlock*[B_];
-        for (size_t j = 0; j < B_; ++j) tmp[j] = nullptr;
+    // Po split-e sa predpokladá, že posledný B-blok je plný.
+    n0_ = B_;
+    updateLayout();
+}
 
-        for (size_t j = 0; j < B_; ++j) {
-            tmp[j] = new DataBlock(smallSize);
-            for (size_t p = 0; p < smallSize; ++p) {
-                tmp[j]->data[p] = big->data[j * smallSize + p];
-            }
-        }
-        delete big;
+template<typename T, size_t R>
+void ResizableArray<T, R>::rebuild(size_t newB) {
+    if (newB < 2 || (newB & (newB - 1)) != 0) {
+        throw std::invalid_argument("rebuild: B must be a power of two");
+    }
 
-        if (i == 1) {
-            // Na úrovni 1 uložíme všetkých B blokov.
-            for (size_t j = 0; j < B_; ++j) {
-                levels_[1].push_back(tmp[j]);
+    // Celkový rebuild počas postupného najprv dokončí ten postupný.
+    finishMigration();
+
+    relayout(newB, 0, [](DataBlock&, size_t) {});
+}
+
+template<typename T, size_t R>
+template<typename Fill>
+void ResizableArray<T, R>::relayout(size_t newB, size_t extra, Fill fillExtra) {
+    RARRAY_TIME_OP(opRebuild_);
+    // Pri priamom volaní s príliš malým B by sa N prvkov nezmestilo do B^R.
+    const size_t total = N_ + extra;
+    while (power(newB, R) < total) newB *= 2;
+
+    // Nová geometria vzniká vedľa starej a plní sa priamo zo starých blokov
+    // v poradí indexov. Každý starý blok sa uvoľní hneď, ako sa vyprázdni, takže
+    // navyše držíme len rozpracovaný nový blok a jeden čiastočne vyprázdnený starý
+    // (O(B'^(R-1)) namiesto dočasného bufferu všetkých N prvkov).
+    DynamicArray<DataBlock> oldLevels[R];
+    size_t oldCounts[R];
+    size_t liveBytes = 0; // bajty starých aj nových blokov, ktoré práve existujú
+    for (size_t i = 0; i < R; ++i) {
+        oldLevels[i].swap(levels_[i]);
+        oldCounts[i] = n_[i];
+        for (size_t j = 0; j < n_[i]; ++j) liveBytes += oldLevels[i].data[j]->capacity * sizeof(T);
+    }
+    size_t peakBytes = liveBytes;
+
+    B_ = newB;
+    initializeLevels();
+
+    // Kurzor v starej štruktúre: úroveň, blok a koľko prvkov z neho už odišlo
+    size_t srcLvl = R - 1;
+    size_t srcBlk = 0;
+    size_t srcOff = 0;
+    auto skipEmpty = [&] {
+        while (srcLvl >= 1 && srcBlk >= oldCounts[srcLvl]) {
+            --srcLvl;
+            srcBlk = 0;
+        }
+    };
+    skipEmpty();
+
+    try {
+        fillLevels(total, [&](DataBlock& dst, size_t count) {
+            if (dst.size == 0) {
+                liveBytes += dst.capacity * sizeof(T);
+                if (liveBytes > peakBytes) peakBytes = liveBytes;
             }
-            n_[1] += B_;
-            delete[] tmp;
-            break; // hotovo
-        } else {
-            // Na úrovni i uložíme prvých B-1 blokov, posledný delíme ďalej.
-            for (size_t j = 0; j + 1 < B_; ++j) {
-                levels_[i].push_back(tmp[j]);
+            while (count > 0 && srcLvl >= 1) {
+                DataBlock* src = oldLevels[srcLvl].data[srcBlk];
+                const size_t avail = src->size - srcOff;
+                const size_t take  = (avail < count ? avail : count);
+                relocateElements(dst.data + dst.size, src->data + srcOff, take);
+                dst.size += take;
+                srcOff   += take;
+                count    -= take;
+
+                if (srcOff == src->size) {
+                    // starý blok je celý presunutý - hneď ho uvoľníme
+                    src->size = 0;
+                    liveBytes -= src->capacity * sizeof(T);
+                    disposeBlock(src);
+                    oldLevels[srcLvl].data[srcBlk] = nullptr;
+                    ++srcBlk;
+                    srcOff = 0;
+                    skipEmpty();
+                }
             }
-            n_[i] += (B_ - 1);
-            big = tmp[B_ - 1];
-            delete[] tmp;
+            // staré prvky sú minuté - ďalej idú nové
+            if (count > 0) fillExtra(dst, count);
+        });
+    } catch (...) {
+        // Bez kópie všetkých prvkov sa pôvodný stav obnoviť nedá:
+        // zničíme zvyšok a pole ostane prázdne (ale konzistentné).
+        if (srcLvl >= 1) {
+            DataBlock* src = oldLevels[srcLvl].data[srcBlk];
+            std::destroy(src->data + srcOff, src->data + src->size);
+            src->size = 0;
         }
+        cleanupLevels(); // zvyšné staré bloky zmaže deštruktor oldLevels
+        throw;
+    }
+    if (peakBytes > peakRebuildBytes_) peakRebuildBytes_ = peakBytes;
+
+    // všetky bloky sú už presunuté, oldLevels uvoľní len svoje tabuľky
+}
 
-        if (i == 1) break; // underflow guard
+template<typename T, size_t R>
+template<typename Fill>
+void ResizableArray<T, R>::fillLevels(size_t count, Fill fill) {
+    // Kanonické rozloženie: čo najviac blokov najvyššej úrovne, potom nižšie úrovne
+    // (na každej menej než B blokov) a zvyšok v B-blokoch úrovne 1.
+    // Všetky počítadlá tak ostanú <= 2B, ako to vyžadujú combineBlocks/splitBlocks.
+    size_t remaining = count;
+    for (size_t lvl = R - 1; lvl >= 1; --lvl) {
+        const size_t blockSize = layout_.blockSize[lvl];
+        size_t blocks = remaining >> layout_.shift[lvl];
+        if (lvl == 1 && (remaining & (blockSize - 1)) != 0) ++blocks; // posledný čiastočný
+
+        for (size_t b = 0; b < blocks; ++b) {
+            const size_t take = (remaining < blockSize ? remaining : blockSize);
+            DataBlock* block = acquireBlock(lvl);
+            levels_[lvl].push_back(block); // úroveň ho vlastní, aj keby fill hodil výnimku
+            n_[lvl] += 1;
+            fill(*block, take);
+            remaining -= take;
+            N_ += take;
+            if (lvl == 1) n0_ = take;
+        }
     }
+    updateLayout();
+}
 
-    // Po split-e sa predpokladá, že posledný B-blok je plný.
-    n0_ = B_;
+template<typename T, size_t R>
+void ResizableArray<T, R>::beginMigration(size_t newB) {
+    // Stará štruktúra si odnesie všetky bloky; *this začína prázdne s novým B.
+    auto* draining = new ResizableArray(std::move(*this));
+    draining->retiring_    = true;
+    draining->incremental_ = false;
+
+    B_ = newB;
+    initializeLevels();
+    old_ = draining;
 }
 
 template<typename T, size_t R>
-void ResizableArray<T, R>::rebuild(size_t newB) {
-    // Bez std::vector (podľa zadania). Zálohujeme prvky do raw bufferu.
-    const size_t oldN = N_;
-    T* buffer = nullptr;
-    size_t constructed = 0;
-    if (oldN > 0) {
-        buffer = static_cast<T*>(::operator new(sizeof(T) * oldN));
+void ResizableArray<T, R>::migrateStep() {
+    if (!old_) return;
+
+    // Najviac B_ presunov na operáciu: aj blok B^(r-1) starej geometrie
+    // sa presúva po kusoch (zvyšok čaká v carry_).
+    size_t budget = B_;
+    while (budget > 0) {
+        if (carryLength() == 0) {
+            dropCarry();
+            if (old_->N_ == 0) break;
+            carry_ = old_->takeFrontBlock();
+            carryOff_ = 0;
+        }
+        prepareBack();
+        DataBlock* tail = levels_[1].data[n_[1] - 1];
+        size_t take = carryLength();
+        if (take > B_ - n0_) take = B_ - n0_;
+        if (take > budget) take = budget;
         try {
-            for (size_t i = 0; i < oldN; ++i) {
-                new (buffer + i) T(get(i));
-                ++constructed;
-            }
+            relocateElements(tail->data + n0_, carry_->data + carryOff_, take);
         } catch (...) {
-            for (size_t j = 0; j < constructed; ++j) buffer[j].~T();
-            ::operator delete(buffer);
+            // carry_ ostal celý, stačí vrátiť prípadný nový prázdny B-blok
+            dropEmptyTail();
             throw;
         }
+        tail->size += take;
+        n0_       += take;
+        N_        += take;
+        carryOff_ += take;
+        budget    -= take;
     }
 
-    // Vyčistiť starú štruktúru a zmeniť parameter B
-    cleanupLevels();
-    B_ = newB;
-    initializeLevels();
-
-    // Znovu vložiť všetky hodnoty
-    for (size_t i = 0; i < constructed; ++i) {
-        push_back(buffer[i]);
-        buffer[i].~T();
+    if (carryLength() == 0 && old_->N_ == 0) {
+        dropCarry();
+        delete old_;
+        old_ = nullptr;
     }
-    ::operator delete(buffer);
 }
 
 template<typename T, size_t R>
-void ResizableArray<T, R>::copyFrom(const ResizableArray& other) {
-    // Bezpečná (hoci pomalšia) implementácia: skopíruj obsah cez push_back(get(i)).
-    // Táto cesta sa vyhne problémom s kopírovaním neinitializovaných prvkov
-    // v poslednom B-bloku a zároveň automaticky zachová konzistenciu počítadiel.
+void ResizableArray<T, R>::dropCarry() {
+    if (!carry_) return;
+    std::destroy(carry_->data + carryOff_, carry_->data + carry_->size);
+    carry_->size = 0; // [0, carryOff_) sú už presunuté
+    delete carry_;
+    carry_ = nullptr;
+    carryOff_ = 0;
+}
 
-    // Ak sme "moved-from", musíme znovu alokovať interné polia.
-    if (!levels_ || !n_) {
-        delete[] levels_;
-        delete[] n_;
-        levels_ = nullptr;
-        n_ = nullptr;
-    }
+template<typename T, size_t R>
+void ResizableArray<T, R>::finishMigration() {
+    while (old_) migrateStep();
+}
 
-    B_ = other.B_;
-    initializeLevels(); // vymaže a pripraví štruktúru s novým B_
+template<typename T, size_t R>
+void ResizableArray<T, R>::setIncrementalRebuild(bool enabled) {
+    if (!enabled) finishMigration();
+    incremental_ = enabled;
+}
+
+template<typename T, size_t R>
+typename ResizableArray<T, R>::DataBlock* ResizableArray<T, R>::takeFrontBlock() {
+    // Prvý blok leží na najvyššej neprázdnej úrovni (volá sa len pre N_ > 0).
+    size_t lvl = R - 1;
+    while (n_[lvl] == 0) --lvl;
+
+    DynamicArray<DataBlock>& level = levels_[lvl];
+    DataBlock* block = level.data[0];
+    level.detach_front(1);
+
+    n_[lvl] -= 1;
+    N_ -= block->size;
+    if (lvl == 1 && n_[1] == 0) n0_ = 0; // odišiel aj posledný (čiastočný) B-blok
+    updateLayout();
+    return block;
+}
 
-    for (size_t i = 0; i < other.N_; ++i) {
-        push_back(other.get(i));
+template<typename T, size_t R>
+void ResizableArray<T, R>::relocateElements(T* dst, T* src, size_t count) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // POD a podobné typy sa dajú presunúť jedným memcpy celého bloku
+        if (count > 0) std::memcpy(dst, src, count * sizeof(T));
+    } else {
+        // Zdroj ničíme až keď sú všetky kópie hotové: pri výnimke ostane src celý
+        // (move_if_noexcept kopíruje, ak by presun mohol hodiť) a dst prázdny.
+        size_t p = 0;
+        try {
+            for (; p < count; ++p) {
+                std::construct_at(dst + p, std::move_if_noexcept(src[p]));
+            }
+        } catch (...) {
+            std::destroy(dst, dst + p);
+            throw;
+        }
+        std::destroy(src, src + count);
     }
 }
 
+template<typename T, size_t R>
+void ResizableArray<T, R>::copyFrom(const ResizableArray& other) {
+    // Štruktúru nestaviame znova cez push_back: prevezmeme rovnaké B_, n_[] a n0_
+    // a každý blok skopírujeme jednou alokáciou a jedným hromadným kopírovaním
+    // (pre triviálne T memcpy). Vlastný zdroj pamäte a nastavenia *this ostávajú.
+    B_ = other.B_;
+    initializeLevels(); // vymaže a pripraví štruktúru s novým B_
 
+    if (other.old_) {
+        // Rozpracovaný postupný rebuild nekopírujeme - kópia rovno dostane
+        // kanonický tvar (jeden relayout nad všetkými prvkami)
+        appendSegments(other.segments().begin(), 0, other.length(), [](const T* src, size_t n, T* dst) {
+            std::uninitialized_copy_n(src, n, dst);
+        });
+        return;
+    }
 
+    try {
+        for (size_t i = 1; i < R; ++i) {
+            levels_[i].reserve(other.n_[i]);
+            for (size_t j = 0; j < other.n_[i]; ++j) {
+                const DataBlock* src = other.levels_[i].data[j];
+                DataBlock* dst = acquireBlock(i);
+                try {
+                    std::uninitialized_copy_n(src->data, src->size, dst->data);
+                } catch (...) {
+                    releaseBlock(i, dst);
+                    throw;
+                }
+                dst->size = src->size;
+                levels_[i].push_back(dst);
+                n_[i] += 1;
+            }
+        }
+    } catch (...) {
+        initializeLevels(); // skopírované bloky zahodíme, pole ostane prázdne
+        throw;
+    }
 
+    N_  = other.N_;
+    n0_ = other.n0_;
+    updateLayout();
+}
 
 // ==================== PUBLIC METHODS (FULL IMPLEMENTATION) ====================
 
 template<typename T, size_t R>
 ResizableArray<T, R>::ResizableArray(const ResizableArray& other)
-    : B_(other.B_), N_(0), n0_(0), levels_(nullptr), n_(nullptr) {
-    initializeLevels();
-    for (size_t i = 0; i < other.N_; ++i) {
-        push_back(other.get(i));
-    }
+    : N_(0), B_(other.B_), n0_(0),
+      incremental_(other.incremental_), pool_(other.pool_), retainTail_(other.retainTail_) {
+    copyFrom(other);
 }
 
 template<typename T, size_t R>
 ResizableArray<T, R>::ResizableArray(ResizableArray&& other) noexcept
-    : N_(other.N_), B_(other.B_), levels_(other.levels_), n_(other.n_), n0_(other.n0_) {
+    : N_(other.N_), B_(other.B_), n0_(other.n0_), layout_(other.layout_), old_(other.old_),
+      carry_(other.carry_), carryOff_(other.carryOff_),
+      incremental_(other.incremental_), retiring_(other.retiring_),
+      resource_(other.resource_), largeResource_(other.largeResource_), largeFrom_(other.largeFrom_),
+      pool_(other.pool_), retainTail_(other.retainTail_) {
 
-    other.levels_ = nullptr;
-    other.n_      = nullptr;
+    // Tabuľky úrovní sú v objekte - prevezmeme ich obsah, other ostane prázdne
+    for (size_t i = 0; i < R; ++i) {
+        levels_[i].swap(other.levels_[i]);
+        n_[i] = other.n_[i];
+        other.n_[i] = 0;
+        spare_[i] = other.spare_[i];
+        other.spare_[i] = nullptr;
+    }
+    other.old_    = nullptr;
+    other.carry_  = nullptr;
+    other.carryOff_ = 0;
     other.N_      = 0;
     other.n0_     = 0;
+    other.updateLayout();
 }
 
 
@@ -440,25 +797,7 @@ template<typename T, size_t R>
 ResizableArray<T, R>& ResizableArray<T, R>::operator=(const ResizableArray& other) {
     if (this == &other) return *this;
 
-    // Ak sme moved-from (levels_/n_ == nullptr), musíme najprv znovu vytvoriť interné polia.
-    B_ = other.B_;
-    if (!levels_ || !n_) {
-        delete[] levels_;
-        delete[] n_;
-        levels_ = nullptr;
-        n_ = nullptr;
-        initializeLevels();
-    } else {
-        cleanupLevels();
-        // initializeLevels() by tiež fungovalo, ale cleanup + reserve je lacnejšie.
-        for (size_t i = 1; i < R; ++i) {
-            levels_[i].reserve(2 * B_);
-        }
-    }
-
-    for (size_t i = 0; i < other.N_; ++i) {
-        push_back(other.get(i));
-    }
+    copyFrom(other);
     return *this;
 }
 
@@ -467,19 +806,37 @@ ResizableArray<T, R>& ResizableArray<T, R>::operator=(ResizableArray&& other) no
     if (this == &other) return *this;
 
     cleanupLevels();
-    delete[] levels_;
-    delete[] n_;
+    releaseSpares();
 
+    // Bloky si so sebou nesú svoj zdroj, preto môžeme prevziať aj resource_
     N_      = other.N_;
     B_      = other.B_;
     n0_     = other.n0_;
-    levels_ = other.levels_;
-    n_      = other.n_;
+    layout_ = other.layout_;
+    old_    = other.old_;
+    carry_  = other.carry_;
+    carryOff_ = other.carryOff_;
+    incremental_ = other.incremental_;
+    retiring_    = other.retiring_;
+    resource_    = other.resource_;
+    largeResource_ = other.largeResource_;
+    largeFrom_     = other.largeFrom_;
+    pool_        = other.pool_;
+    retainTail_  = other.retainTail_;
+    for (size_t i = 0; i < R; ++i) {
+        levels_[i].swap(other.levels_[i]); // other dostane naše (prázdne) tabuľky
+        n_[i] = other.n_[i];
+        other.n_[i] = 0;
+        spare_[i] = other.spare_[i];
+        other.spare_[i] = nullptr;
+    }
 
-    other.levels_ = nullptr;
-    other.n_      = nullptr;
+    other.old_    = nullptr;
+    other.carry_  = nullptr;
+    other.carryOff_ = 0;
     other.N_      = 0;
     other.n0_     = 0;
+    other.updateLayout();
 
     return *this;
 }
@@ -488,53 +845,139 @@ ResizableArray<T, R>& ResizableArray<T, R>::operator=(ResizableArray&& other) no
 // ==================== HLAVNÉ OPERÁCIE ====================
 
 template<typename T, size_t R>
-void ResizableArray<T, R>::push_back(const T& item) {
+bool ResizableArray<T, R>::backNeedsRestructure() const {
+    return (!retiring_ && N_ == layout_.growAt) || (n_[1] == 2 * B_ && n0_ == B_);
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::prepareBack() {
     // Dôležité: tieto kroky NESMÚ byť else-if reťazec.
     // Po combineBlocks() je posledný B-blok stále plný (n0_==B_), takže musíme vedieť
     // následne alokovať nový B-blok pred zápisom.
 
-    if (N_ == power(B_, R)) {
+    if (!retiring_ && N_ == layout_.growAt) {
         rebuild(2 * B_);
     }
     if (n_[1] == 2 * B_ && n0_ == B_) {
         combineBlocks();
     }
     if (n_[1] == 0 || n0_ == B_) {
-        levels_[1].push_back(new DataBlock(B_));
+        levels_[1].push_back(acquireBlock(1));
         n_[1] += 1;
         n0_ = 0;
     }
+}
 
-    levels_[1].at(n_[1] - 1)->data[n0_] = item;
+template<typename T, size_t R>
+template<typename... Args>
+T& ResizableArray<T, R>::placeBack(Args&&... args) {
+    DataBlock* tail = levels_[1].data[n_[1] - 1];
+    T* slot;
+    try {
+        slot = std::construct_at(tail->data + n0_, std::forward<Args>(args)...);
+    } catch (...) {
+        // Nevydarený konštruktor nesmie nechať na konci prázdny B-blok
+        dropEmptyTail();
+        throw;
+    }
+    tail->size += 1;
     n0_ += 1;
     N_  += 1;
+    return *slot;
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::dropEmptyTail() {
+    if (n_[1] > 0 && n0_ == 0) {
+        releaseBlock(1, levels_[1].take_back());
+        n_[1] -= 1;
+        n0_ = (n_[1] == 0 ? 0 : B_);
+    }
+}
+
+template<typename T, size_t R>
+template<typename... Args>
+T& ResizableArray<T, R>::emplace_back(Args&&... args) {
+    if (old_ || (incremental_ && N_ == layout_.growAt)) {
+        // Postupný rebuild (prebieha alebo práve začína) presúva bloky,
+        // takže prvok vyrobíme vopred, rovnako ako pred combineBlocks.
+        T item(std::forward<Args>(args)...);
+        if (!old_) beginMigration(2 * B_);
+        migrateStep();
+        // Kým sú v starej geometrii prvky, koniec poľa je v nej.
+        if (old_) return old_->emplace_back(std::move(item));
+        return emplace_back(std::move(item));
+    }
+    if (backNeedsRestructure()) {
+        // args môžu odkazovať na prvok tohto poľa - vyrobíme nový prvok skôr,
+        // než ho rebuild/combineBlocks presunie
+        T item(std::forward<Args>(args)...);
+        prepareBack();
+        return placeBack(std::move(item));
+    }
+    prepareBack(); // najviac alokuje nový B-blok, existujúce prvky sa nehýbu
+    return placeBack(std::forward<Args>(args)...);
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::push_back(const T& item) {
+    emplace_back(item);
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::push_back(T&& item) {
+    emplace_back(std::move(item));
 }
 
 template<typename T, size_t R>
 void ResizableArray<T, R>::shrink() {
-    if (N_ == 0) {
+    if (empty()) {
         throw std::out_of_range("shrink on empty array");
     }
 
     // Rebuild(B/2) keď N = (B/4)^r (len ak B>=4*2, aby B/4 >= 2)
-    if (B_ >= 8 && N_ == power(B_ / 4, R)) {
+    if (!old_ && !retiring_ && N_ == layout_.shrinkAt) {
         // Podľa PDF: shrink musí stále odstrániť 1 prvok aj keď došlo k rebuild.
-        rebuild(B_ / 2);
+        if (incremental_) beginMigration(B_ / 2);
+        else rebuild(B_ / 2);
         // pokračujeme ďalej a odstránime jeden prvok
     }
 
+    if (old_) {
+        migrateStep();
+        // Posledný prvok je v starej geometrii, kým v nej niečo ostáva,
+        // potom na konci carry_.
+        if (old_) {
+            if (old_->N_ > 0) {
+                old_->shrink();
+            } else {
+                std::destroy_at(carry_->data + carry_->size - 1);
+                carry_->size -= 1;
+            }
+            if (carryLength() == 0 && old_->N_ == 0) {
+                dropCarry();
+                delete old_;
+                old_ = nullptr;
+            }
+            return;
+        }
+    }
+
     if (n_[1] == 0) {
         splitBlocks(); // musí vyrobiť B-bloky
     }
 
-    // odstráň posledný prvok
+    // odstráň posledný prvok (a hneď ho zničíme, nech uvoľní svoje zdroje)
+    DataBlock* tail = levels_[1].data[n_[1] - 1];
+    std::destroy_at(tail->data + n0_ - 1);
+    tail->size -= 1;
     n0_ -= 1;
     N_  -= 1;
 
     // ak sa posledný B-blok vyprázdnil, dealokuj ho
     if (n0_ == 0) {
-        // aby pop_back nezmazal blok skôr než chceme: zmažeme ho cez pop_back owner logikou
-        levels_[1].pop_back();
+        // prázdny blok ide späť do poolu (ak je zapnutý), inak sa zmaže
+        releaseBlock(1, levels_[1].take_back());
         n_[1] -= 1;
 
         if (N_ == 0 || n_[1] == 0) {
@@ -547,64 +990,473 @@ void ResizableArray<T, R>::shrink() {
 
 template<typename T, size_t R>
 T& ResizableArray<T, R>::get(size_t index) {
-    if (index >= N_) throw std::out_of_range("get: index out of range");
+    if (index >= length()) throw std::out_of_range("get: index out of range");
+    return get_unchecked(index);
+}
 
-    size_t x = index;
+template<typename T, size_t R>
+const T& ResizableArray<T, R>::get(size_t index) const {
+    return const_cast<ResizableArray*>(this)->get(index);
+}
 
-    // Najprv veľké bloky (úrovne r-1 ... 2) — tie majú nižšie indexy
-    for (size_t lvl = R - 1; lvl >= 2; --lvl) {
-        const size_t blockSize = power(B_, lvl);          // B^lvl
-        const size_t levelItems = n_[lvl] * blockSize;
+template<typename T, size_t R>
+T& ResizableArray<T, R>::get_unchecked(size_t index) {
+    // Za N_ môžu byť už len prvky starej geometrie (počas postupného rebuildu)
+    if (index >= N_) [[unlikely]] return migratingItem(index - N_);
+
+    // Najprv veľké bloky (úrovne r-1 ... 2) — tie majú nižšie indexy,
+    // hranice úrovní sú predpočítané v layout_, takže stačí pár porovnaní.
+    const size_t lvl = levelOf(index);
+
+    // Na úrovni 1 je posledný blok čiastočný, ale adresovanie je rovnaké.
+    // Bloky majú veľkosť 2^shift, takže namiesto / a % stačí posun a maska.
+    const size_t x = index - layout_.start[lvl];
+    const size_t mask = layout_.blockSize[lvl] - 1;
+    return levels_[lvl].items[x >> layout_.shift[lvl]][x & mask];
+}
 
-        if (x < levelItems) {
-            const size_t b = x / blockSize;
-            const size_t off = x % blockSize;
-            return levels_[lvl].at(b)->data[off];
+template<typename T, size_t R>
+const T& ResizableArray<T, R>::get_unchecked(size_t index) const {
+    return const_cast<ResizableArray*>(this)->get_unchecked(index);
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::get_many(const size_t* idx, size_t n, T* out) const {
+    // Dávka: najprv úrovne všetkých indexov, potom (s prefetchom) položky
+    // tabuliek blokov, adresy prvkov a až nakoniec čítanie - namiesto
+    // n závislých reťazcov za sebou.
+    constexpr size_t BATCH = 64;
+    size_t lvl[BATCH];
+    const T* src[BATCH];
+    const size_t total = length();
+
+    for (size_t base = 0; base < n; base += BATCH) {
+        const size_t m = (n - base < BATCH ? n - base : BATCH);
+        const size_t* in = idx + base;
+
+        rarray_detail::levelsOf<LEVELS - 1>(in, m, layout_.start + 1, lvl);
+
+        // 1. prechod: položky items[] (tabuľka blokov), ich čítanie sa prekrýva
+        T* const* slot[BATCH];
+        for (size_t k = 0; k < m; ++k) {
+            const size_t i = in[k];
+            if (i >= N_) [[unlikely]] {
+                if (i >= total) throw std::out_of_range("get_many: index out of range");
+                slot[k] = nullptr;
+                continue;
+            }
+            const size_t l = lvl[k];
+            slot[k] = levels_[l].items + ((i - layout_.start[l]) >> layout_.shift[l]);
+            RARRAY_PREFETCH(slot[k]);
+        }
+
+        // 2. prechod: adresy prvkov
+        for (size_t k = 0; k < m; ++k) {
+            const size_t i = in[k];
+            if (!slot[k]) [[unlikely]] {
+                src[k] = &migratingItem(i - N_); // počas postupného rebuildu
+                continue;
+            }
+            const size_t l = lvl[k];
+            src[k] = *slot[k] + ((i - layout_.start[l]) & (layout_.blockSize[l] - 1));
+            RARRAY_PREFETCH(src[k]);
         }
-        x -= levelItems;
 
-        if (lvl == 2) break; // ochrana pred underflow pre size_t
+        for (size_t k = 0; k < m; ++k) {
+            out[base + k] = *src[k];
+        }
     }
+}
 
-    // Teraz úroveň 1 (bloky veľkosti B), posledný môže byť čiastočný
-    if (n_[1] == 0) throw std::runtime_error("get: internal n1==0");
+template<typename T, size_t R>
+void ResizableArray<T, R>::set(size_t index, const T& item) {
+    get(index) = item;
+}
 
-    const size_t fullPart = (n_[1] > 0 ? (n_[1] - 1) * B_ : 0);
+template<typename T, size_t R>
+void ResizableArray<T, R>::set(size_t index, T&& item) {
+    get(index) = std::move(item);
+}
 
-    if (x < fullPart) {
-        const size_t b = x / B_;
-        const size_t off = x % B_;
-        return levels_[1].at(b)->data[off];
-    } else {
-        x -= fullPart;                  // v poslednom (čiastočnom) bloku
-        if (x >= n0_) throw std::runtime_error("get: past n0");
-        return levels_[1].at(n_[1] - 1)->data[x];
+// ==================== SEGMENTY ====================
+
+template<typename T, size_t R>
+template<typename F>
+void ResizableArray<T, R>::for_each_segment(F f) {
+    for (std::span<T> segment : segments()) {
+        f(segment);
     }
 }
 
 template<typename T, size_t R>
-const T& ResizableArray<T, R>::get(size_t index) const {
-    return const_cast<ResizableArray*>(this)->get(index);
+template<typename F>
+void ResizableArray<T, R>::for_each_segment(F f) const {
+    for (std::span<const T> segment : segments()) {
+        f(segment);
+    }
 }
 
 template<typename T, size_t R>
-void ResizableArray<T, R>::set(size_t index, const T& item) {
-    get(index) = item;
+template<bool Reverse, typename Self, typename G>
+void ResizableArray<T, R>::walkBlocks(Self& self, G& g) {
+    // Počas postupného rebuildu nasledujú za prvkami *this prvky carry_ a old_
+    if (Reverse && self.old_) {
+        walkBlocks<Reverse>(*self.old_, g);
+        if (self.carryLength() > 0) g(self.carry_->data + self.carryOff_, self.carryLength());
+    }
+
+    for (size_t step = 0; step < LEVELS; ++step) {
+        const size_t lvl = (Reverse ? 1 + step : R - 1 - step);
+        const size_t blocks = self.n_[lvl];
+        auto* const* items = self.levels_[lvl].items;
+        for (size_t k = 0; k < blocks; ++k) {
+            const size_t j = (Reverse ? blocks - 1 - k : k);
+            // položka tabuľky bloku o dva ďalej (ďalší už g dostane ako lookahead)
+            if (k + 2 < blocks) RARRAY_PREFETCH(items + (Reverse ? j - 2 : j + 2));
+            const size_t len = (lvl == 1 && j + 1 == blocks ? self.n0_ : self.layout_.blockSize[lvl]);
+            g(items[j], len);
+        }
+    }
+
+    if (!Reverse && self.old_) {
+        if (self.carryLength() > 0) g(self.carry_->data + self.carryOff_, self.carryLength());
+        walkBlocks<Reverse>(*self.old_, g);
+    }
+}
+
+template<typename T, size_t R>
+template<typename Self, typename F>
+void ResizableArray<T, R>::scanImpl(Self& self, size_t from, std::ptrdiff_t stride, F& f) {
+    using Elem = std::conditional_t<std::is_const_v<Self>, const T, T>;
+    if (stride == 0) throw std::invalid_argument("scan: stride must not be zero");
+    const size_t total = self.length();
+    if (total == 0) return;
+    if (from >= total) throw std::out_of_range("scan: start index out of range");
+
+    const bool reverse = stride < 0;
+    const size_t step = (reverse ? static_cast<size_t>(-(stride + 1)) + 1 : static_cast<size_t>(stride));
+
+    // Pozície sa počítajú v smere prechodu: 0 je prvý prvok, ktorý prechod
+    // stretne (pri reverse posledný prvok poľa); k-ty prvok bloku v tomto
+    // smere je data[k], resp. data[len - 1 - k].
+    size_t blockStart = 0;                            // pozícia prvého prvku bloku
+    size_t next = (reverse ? total - 1 - from : from); // ďalšia navštívená pozícia
+
+    auto process = [&](Elem* data, size_t len, Elem* ahead, size_t aheadLen) {
+        const size_t end = blockStart + len;
+        if (next < end) {
+            size_t k = next - blockStart;
+            const size_t last = k + (len - 1 - k) / step * step;
+            // kde prechod dopadne v ďalšom bloku: tie cache line načítať už teraz
+            const size_t land = last + step - len;
+            if (ahead && land < aheadLen) {
+                const size_t room = (aheadLen - land) * sizeof(T);
+                const char* p = reinterpret_cast<const char*>(ahead + (reverse ? aheadLen - 1 - land : land));
+                for (size_t c = 0; c < SCAN_PREFETCH_LINES && c * 64 < room; ++c) {
+                    RARRAY_PREFETCH(reverse ? p - c * 64 : p + c * 64);
+                }
+            }
+            // step == 1 zvlášť: s konštantným krokom kompilátor slučku zvektorizuje
+            if (reverse && step == 1) {
+                for (size_t i = len - k; i-- > 0;) f(data[i]);
+            } else if (reverse) {
+                for (; k < len; k += step) f(data[len - 1 - k]);
+            } else if (step == 1) {
+                for (; k < len; ++k) f(data[k]);
+            } else {
+                for (; k < len; k += step) f(data[k]);
+            }
+            next = blockStart + last + step;
+        }
+        blockStart = end;
+    };
+
+    // Blok sa spracuje, až keď je známy ďalší (ten sa medzitým prefetchuje)
+    Elem* pending = nullptr;
+    size_t pendingLen = 0;
+    auto visit = [&](Elem* data, size_t len) {
+        if (len == 0) return;
+        if (pending) process(pending, pendingLen, data, len);
+        pending = data;
+        pendingLen = len;
+    };
+    if (reverse) walkBlocks<true>(self, visit);
+    else walkBlocks<false>(self, visit);
+    if (pending) process(pending, pendingLen, nullptr, 0);
+}
+
+template<typename T, size_t R>
+template<typename F>
+void ResizableArray<T, R>::scan(std::ptrdiff_t stride, F f) {
+    scan(stride < 0 && !empty() ? length() - 1 : 0, stride, f);
+}
+
+template<typename T, size_t R>
+template<typename F>
+void ResizableArray<T, R>::scan(std::ptrdiff_t stride, F f) const {
+    scan(stride < 0 && !empty() ? length() - 1 : 0, stride, f);
+}
+
+template<typename T, size_t R>
+template<typename F>
+void ResizableArray<T, R>::scan(size_t from, std::ptrdiff_t stride, F f) {
+    scanImpl(*this, from, stride, f);
+}
+
+template<typename T, size_t R>
+template<typename F>
+void ResizableArray<T, R>::scan(size_t from, std::ptrdiff_t stride, F f) const {
+    scanImpl(*this, from, stride, f);
 }
 
 // ==================== INE OPERÁCIE ====================
+template<typename T, size_t R>
+bool ResizableArray<T, R>::canAppendInBulk(size_t count) const {
+    if (old_) return false;
+    if (!incremental_) return true;
+
+    // Prestavba na nové B je O(N); pri postupnom rebuilde si ju dovolíme,
+    // len keď ju zaplatí samotná dávka (count >= N)
+    size_t newB = B_;
+    while (power(newB, R) < N_ + count) newB *= 2;
+    return newB == B_ || count >= N_;
+}
+
+template<typename T, size_t R>
+template<typename Copy>
+void ResizableArray<T, R>::appendCounted(size_t count, Copy copy) {
+    if (count == 0) return;
+
+    // Výsledné B poznáme vopred - prvky by po jednom prešli cez všetky medzi-rebuildy
+    size_t newB = B_;
+    while (power(newB, R) < N_ + count) newB *= 2;
+
+    if (newB != B_ || count >= N_) {
+        // Prestavba je nutná (alebo ju dávka aj tak zaplatí): staré aj nové prvky
+        // rozložíme rovno do kanonického tvaru, každý nový prvok sa zapíše raz.
+        relayout(newB, count, [&](DataBlock& dst, size_t n) {
+            copy(dst.data + dst.size, n);
+            dst.size += n;
+        });
+        return;
+    }
+
+    // Geometria ostáva: dopĺňame posledný B-blok po celých kusoch,
+    // combineBlocks sa volá rovnako ako pri push_back (rebuild už nenastane).
+    while (count > 0) {
+        prepareBack();
+        DataBlock* tail = levels_[1].data[n_[1] - 1];
+        const size_t take = (B_ - n0_ < count ? B_ - n0_ : count);
+        try {
+            copy(tail->data + n0_, take);
+        } catch (...) {
+            dropEmptyTail();
+            throw;
+        }
+        tail->size += take;
+        n0_   += take;
+        N_    += take;
+        count -= take;
+    }
+}
+
+template<typename T, size_t R>
+template<typename InputIt>
+void ResizableArray<T, R>::append(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (canAppendInBulk(count)) {
+            appendCounted(count, [&](T* dst, size_t n) {
+                // pre súvislé triviálne kopírovateľné dáta je to memmove
+                first = std::ranges::uninitialized_copy_n(first, n, dst, dst + n).in;
+            });
+            return;
+        }
+    }
+
+    // Jednoprechodový vstup (počet nepoznáme) alebo prebiehajúci postupný rebuild
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::push_back_all(const ResizableArray& other) {
+    if (&other == this) {
+        // prestavba by zrušila bloky, z ktorých čítame
+        ResizableArray copy(other);
+        push_back_all(copy);
+        return;
+    }
+
+    const size_t count = other.length();
+    if (!canAppendInBulk(count)) {
+        for (const T& item : other) emplace_back(item);
+        return;
+    }
+
+    // Kopírujeme po segmentoch zdroja
+    appendSegments(other.segments().begin(), 0, count, [](const T* src, size_t n, T* dst) {
+        std::uninitialized_copy_n(src, n, dst);
+    });
+}
+
+template<typename T, size_t R>
+template<typename SegIt, typename Relocate>
+void ResizableArray<T, R>::appendSegments(SegIt seg, size_t off, size_t count, Relocate relocate) {
+    // Jeden kus cieľa môže pokryť viac segmentov zdroja a naopak
+    appendCounted(count, [&](T* dst, size_t n) {
+        T* out = dst;
+        try {
+            while (n > 0) {
+                const auto segment = *seg;
+                const size_t take = (segment.size() - off < n ? segment.size() - off : n);
+                relocate(segment.data() + off, take, out);
+                out += take;
+                off += take;
+                n   -= take;
+                if (off == segment.size()) {
+                    ++seg;
+                    off = 0;
+                }
+            }
+        } catch (...) {
+            std::destroy(dst, out);
+            throw;
+        }
+    });
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::appendMoved(ResizableArray&& other) {
+    if (&other == this) return;
+    other.dropEmptyTail();
+    if (N_ == 0 && !old_ && !incremental_ && !other.incremental_ && resource_ == other.resource_) {
+        // prázdny cieľ: stačí prevziať celú štruktúru (nastavenia cieľa ostávajú)
+        const bool pool = pool_, retainTail = retainTail_;
+        *this = std::move(other);
+        setBlockPool(pool);
+        setRetainSpareTail(retainTail);
+        return;
+    }
+
+    const size_t count = other.length();
+    if (!canAppendInBulk(count)) {
+        for (T& item : other) emplace_back(std::move(item));
+        other = ResizableArray(other.resource_);
+        return;
+    }
+
+    // Rovnako ako push_back_all, len presunom; pre triviálne T je to memcpy
+    appendSegments(other.segments().begin(), 0, count, [](T* src, size_t n, T* dst) {
+        std::uninitialized_move_n(src, n, dst);
+    });
+    other = ResizableArray(other.resource_);
+}
+
+template<typename T, size_t R>
+typename ResizableArray<T, R>::Stats ResizableArray<T, R>::stats() const {
+    using Item = typename DynamicArray<DataBlock>::Item;
+
+    Stats s;
+    s.length = length();
+    s.B = B_;
+    s.elementBytes = s.length * sizeof(T);
+
+    size_t tables = 0;
+    for (size_t i = 0; i < R; ++i) {
+        s.blocks[i] = n_[i];
+        for (size_t j = 0; j < n_[i]; ++j) {
+            const DataBlock* block = levels_[i].data[j];
+            s.blockBytes    += block->capacity * sizeof(T);
+            s.slackBytes[i] += (block->capacity - block->size) * sizeof(T);
+        }
+        s.tableBytes[i] = levels_[i].capacity * (sizeof(DataBlock*) + sizeof(Item))
+                        + n_[i] * sizeof(DataBlock);
+        tables += s.tableBytes[i];
+        if (spare_[i]) s.spareBytes += spare_[i]->capacity * sizeof(T) + sizeof(DataBlock);
+    }
+    if (old_) {
+        // stará štruktúra má vlastné bloky aj tabuľky
+        const Stats o = old_->stats();
+        s.migratingBytes = o.totalBytes + sizeof(ResizableArray);
+        if (carry_) s.migratingBytes += carry_->capacity * sizeof(T) + sizeof(DataBlock);
+    }
+    s.totalBytes = s.blockBytes + tables + s.spareBytes + s.migratingBytes;
+    s.peakRebuildBytes = peakRebuildBytes_;
+
+#if RARRAY_INSTRUMENT
+    s.combine = opCombine_;
+    s.split   = opSplit_;
+    s.rebuild = opRebuild_;
+#endif
+    return s;
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::resetStats() {
+    peakRebuildBytes_ = 0;
+#if RARRAY_INSTRUMENT
+    opCombine_ = RArrayOpStats{};
+    opSplit_   = RArrayOpStats{};
+    opRebuild_ = RArrayOpStats{};
+#endif
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::reserve(size_t n) {
+    size_t newB = B_;
+    while (power(newB, R) < n) newB *= 2;
+    if (newB != B_) {
+        rebuild(newB);
+    }
+
+    // Na nižších úrovniach býva najviac 2B blokov (potom combineBlocks),
+    // na najvyššej toľko, koľko najväčších blokov treba na n prvkov.
+    const size_t top = layout_.blockSize[R - 1];
+    for (size_t i = 1; i < R - 1; ++i) {
+        levels_[i].reserve(2 * B_);
+    }
+    levels_[R - 1].reserve((n + top - 1) / top);
+}
+
+template<typename T, size_t R>
+void ResizableArray<T, R>::shrink_to_fit() {
+    finishMigration();
+
+    size_t minB = INITIAL_B;
+    while (power(minB, R) < N_) minB *= 2;
+    if (minB < B_) {
+        rebuild(minB);
+    }
+
+    for (size_t i = 0; i < R; ++i) {
+        levels_[i].shrink_to_fit();
+    }
+}
+
 template<typename T, size_t R>
 ResizableArray<T, R> ResizableArray<T, R>::sub_rarray(size_t from, size_t to) const {
-    if (from > to || to > N_) {
+    if (from > to || to > length()) {
         throw std::out_of_range("Invalid sub_rarray range");
     }
 
     ResizableArray<T, R> result;
-
-    for (size_t i = from; i < to; ++i) {
-        result.push_back(get(i));
+    if (from == to) return result;
+
+    // Prvý segment, v ktorom rez začína (O(počet blokov), žiadne hľadanie úrovne na prvok)
+    auto seg = segments().begin();
+    size_t off = from;
+    while (off >= (*seg).size()) {
+        off -= (*seg).size();
+        ++seg;
     }
 
+    // Dĺžku poznáme: geometria výsledku sa zvolí raz a celé úseky blokov
+    // sa kopírujú naraz (pre triviálne T memcpy); po prvkoch len okraje segmentov
+    result.appendSegments(seg, off, to - from, [](const T* src, size_t n, T* dst) {
+        std::uninitialized_copy_n(src, n, dst);
+    });
     return result;
 }
 
@@ -613,14 +1465,111 @@ template<typename Predicate>
 ResizableArray<T, R> ResizableArray<T, R>::filter(Predicate pred) const {
     ResizableArray<T, R> result;
 
-    for (size_t i = 0; i < N_; ++i) {
-        const T& val = get(i);
-        if (pred(val)) {
-            result.push_back(val);
+    for_each_segment([&](std::span<const T> segment) {
+        result.appendFiltered(segment, pred);
+    });
+    result.dropEmptyTail(); // posledný pripravený blok mohol ostať prázdny
+    return result;
+}
+
+template<typename T, size_t R>
+template<typename Predicate>
+void ResizableArray<T, R>::appendFiltered(std::span<const T> segment, Predicate& pred) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // Každý kus zdroja sa "skomprimuje" rovno do voľného miesta v poslednom
+        // B-bloku (compress zapisuje aj na miesta, ktoré hneď prepíše,
+        // preto kus nesmie byť väčší než voľné miesto).
+        const T* src  = segment.data();
+        size_t   left = segment.size();
+        while (left > 0) {
+            prepareBack(); // rebuild/combine, prípadne nový B-blok
+            DataBlock* tail = levels_[1].data[n_[1] - 1];
+            size_t take = B_ - n0_;
+            // kus nesmie preskočiť prah rebuildu (N == B^R)
+            if (layout_.growAt - N_ < take) take = layout_.growAt - N_;
+            if (left < take) take = left;
+
+            const size_t kept = rarray_detail::compress(src, take, tail->data + n0_, pred);
+            tail->size += kept;
+            n0_ += kept;
+            N_  += kept;
+            src  += take;
+            left -= take;
+        }
+    } else {
+        for (const T& val : segment) {
+            if (pred(val)) {
+                push_back(val);
+            }
         }
     }
+}
 
-    return result;
+// ==================== REDUKCIE ====================
+template<typename T, size_t R>
+template<typename U, typename BinaryOp>
+U ResizableArray<T, R>::reduce(U init, BinaryOp op) const {
+    for_each_segment([&](std::span<const T> segment) {
+        for (const T& val : segment) {
+            init = op(std::move(init), val);
+        }
+    });
+    return init;
+}
+
+template<typename T, size_t R>
+T ResizableArray<T, R>::sum() const {
+    T total{};
+    for_each_segment([&](std::span<const T> segment) {
+        total += rarray_detail::sumSpan(segment.data(), segment.size());
+    });
+    return total;
+}
+
+template<typename T, size_t R>
+T ResizableArray<T, R>::min() const {
+    if (empty()) throw std::out_of_range("min on empty array");
+    T best = get_unchecked(0);
+    for_each_segment([&](std::span<const T> segment) {
+        if (segment.empty()) return;
+        const T m = rarray_detail::extremeSpan<false>(segment.data(), segment.size());
+        if (m < best) best = m;
+    });
+    return best;
+}
+
+template<typename T, size_t R>
+T ResizableArray<T, R>::max() const {
+    if (empty()) throw std::out_of_range("max on empty array");
+    T best = get_unchecked(0);
+    for_each_segment([&](std::span<const T> segment) {
+        if (segment.empty()) return;
+        const T m = rarray_detail::extremeSpan<true>(segment.data(), segment.size());
+        if (best < m) best = m;
+    });
+    return best;
+}
+
+template<typename T, size_t R>
+template<typename Predicate>
+size_t ResizableArray<T, R>::count_if(Predicate pred) const {
+    size_t count = 0;
+    for_each_segment([&](std::span<const T> segment) {
+        count += rarray_detail::countSpan(segment.data(), segment.size(), pred);
+    });
+    return count;
+}
+
+template<typename T, size_t R>
+size_t ResizableArray<T, R>::find(const T& value) const {
+    // Po segmentoch, aby sa dalo skončiť hneď pri prvom nájdenom
+    size_t offset = 0;
+    for (std::span<const T> segment : segments()) {
+        const size_t pos = rarray_detail::findSpan(segment.data(), segment.size(), value);
+        if (pos < segment.size()) return offset + pos;
+        offset += segment.size();
+    }
+    return offset;
 }
 
 template<typename T, size_t R>
@@ -629,13 +1578,244 @@ ResizableArray<U, R> ResizableArray<T, R>::flatten() const {
 
     ResizableArray<U, R> result;
 
-    for (size_t i = 0; i < N_; ++i) {
-        const auto& inner = get(i);
+    for_each_segment([&](std::span<const T> segment) {
+        for (const auto& inner : segment) {
+            result.append(std::begin(inner), std::end(inner));
+        }
+    });
+
+    return result;
+}
+
+// ==================== PARALELNÉ OPERÁCIE ====================
+
+template<typename T, size_t R>
+template<typename Policy>
+size_t ResizableArray<T, R>::workerCount(const Policy& policy, size_t count) {
+    if constexpr (!rarray_exec::policy_traits<std::remove_cvref_t<Policy>>::parallel) {
+        (void)policy;
+        (void)count;
+        return 1;
+    } else {
+        // Menej prvkov na vlákno sa neoplatí (vytvorenie vlákna + spájanie výsledkov)
+        constexpr size_t MIN_PER_WORKER = 16384;
+        size_t workers = 0;
+        if constexpr (requires { policy.threads; }) {
+            workers = policy.threads;
+        }
+        if (workers == 0) {
+            workers = std::thread::hardware_concurrency();
+            if (count / MIN_PER_WORKER < workers) workers = count / MIN_PER_WORKER;
+        }
+        if (count < workers) workers = count;
+        return (workers == 0 ? 1 : workers);
+    }
+}
+
+template<typename T, size_t R>
+template<typename Elem>
+std::vector<std::span<Elem>>
+ResizableArray<T, R>::sliceSpans(const std::vector<std::span<Elem>>& spans, size_t from, size_t to) {
+    std::vector<std::span<Elem>> result;
+    size_t segStart = 0;
+    for (std::span<Elem> segment : spans) {
+        const size_t segEnd = segStart + segment.size();
+        if (segEnd > from && segStart < to) {
+            const size_t lo = (from > segStart ? from - segStart : 0);
+            const size_t hi = (to < segEnd ? to - segStart : segment.size());
+            result.push_back(segment.subspan(lo, hi - lo));
+        }
+        if (segEnd >= to) break;
+        segStart = segEnd;
+    }
+    return result;
+}
 
-        for (const auto& x : inner) {
-            result.push_back(x);
+template<typename T, size_t R>
+template<typename Job>
+void ResizableArray<T, R>::runWorkers(size_t workers, Job job) {
+    std::vector<std::exception_ptr> errors(workers);
+    auto guarded = [&](size_t w) {
+        try {
+            job(w);
+        } catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    try {
+        for (size_t w = 0; w + 1 < workers; ++w) {
+            threads.emplace_back(guarded, w);
         }
+    } catch (...) {
+        for (std::thread& t : threads) t.join();
+        throw;
     }
+    guarded(workers - 1);
+    for (std::thread& t : threads) t.join();
+
+    for (std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+template<typename T, size_t R>
+template<typename Out, typename Elem, typename Work>
+Out ResizableArray<T, R>::stitchParallel(const std::vector<std::span<Elem>>& src, size_t total,
+                                         size_t workers, Work work) {
+    if (workers <= 1) {
+        Out result;
+        for (std::span<Elem> segment : src) work(result, segment);
+        return result;
+    }
+
+    const size_t per = (total + workers - 1) / workers;
+    std::vector<Out> partial(workers);
+    runWorkers(workers, [&](size_t w) {
+        const size_t lo = (w * per < total ? w * per : total);
+        const size_t hi = (lo + per < total ? lo + per : total);
+        for (std::span<Elem> segment : sliceSpans(src, lo, hi)) work(partial[w], segment);
+    });
+
+    Out result = std::move(partial[0]);
+    for (size_t w = 1; w < workers; ++w) {
+        result.appendMoved(std::move(partial[w]));
+    }
+    return result;
+}
+
+template<typename T, size_t R>
+template<typename U, typename Elem, typename Fill>
+ResizableArray<U, R> ResizableArray<T, R>::fillParallel(const std::vector<std::span<Elem>>& src, size_t total,
+                                                        size_t workers, Fill fill) {
+    static_assert(std::is_trivially_copyable_v<U> && std::is_trivially_destructible_v<U>);
+
+    // appendCounted len rozloží miesta (prázdne pole => jeden relayout v kanonickom tvare),
+    // zapisovať do nich budú až vlákna
+    ResizableArray<U, R> result;
+    std::vector<std::span<U>> dst;
+    result.appendCounted(total, [&](U* out, size_t n) { dst.push_back(std::span<U>(out, n)); });
+
+    const size_t per = (total + workers - 1) / (workers ? workers : 1);
+    runWorkers(workers ? workers : 1, [&](size_t w) {
+        const size_t lo = (w * per < total ? w * per : total);
+        const size_t hi = (lo + per < total ? lo + per : total);
+        const std::vector<std::span<Elem>> in  = sliceSpans(src, lo, hi);
+        const std::vector<std::span<U>>    out = ResizableArray<U, R>::sliceSpans(dst, lo, hi);
+
+        // hranice blokov zdroja a cieľa sa nekryjú - ideme oboma naraz
+        size_t i = 0, j = 0, inOff = 0, outOff = 0;
+        while (i < in.size() && j < out.size()) {
+            const size_t inLeft  = in[i].size() - inOff;
+            const size_t outLeft = out[j].size() - outOff;
+            const size_t n = (inLeft < outLeft ? inLeft : outLeft);
+            fill(out[j].data() + outOff, in[i].data() + inOff, n);
+            inOff  += n;
+            outOff += n;
+            if (inOff == in[i].size())   { ++i; inOff = 0; }
+            if (outOff == out[j].size()) { ++j; outOff = 0; }
+        }
+    });
+    return result;
+}
 
+template<typename T, size_t R>
+template<typename Policy, typename Predicate>
+    requires rarray_exec::execution_policy<Policy>
+ResizableArray<T, R> ResizableArray<T, R>::filter(Policy&& policy, Predicate pred) const {
+    std::vector<std::span<const T>> spans;
+    for (std::span<const T> segment : segments()) spans.push_back(segment);
+
+    const size_t total = length();
+    ResizableArray result = stitchParallel<ResizableArray>(spans, total, workerCount(policy, total),
+        [&pred](ResizableArray& out, std::span<const T> segment) { out.appendFiltered(segment, pred); });
+    result.dropEmptyTail();
     return result;
+}
+
+template<typename T, size_t R>
+template<typename Policy>
+    requires rarray_exec::execution_policy<Policy>
+ResizableArray<T, R> ResizableArray<T, R>::sub_rarray(Policy&& policy, size_t from, size_t to) const {
+    if (from > to || to > length()) {
+        throw std::out_of_range("Invalid sub_rarray range");
+    }
+
+    std::vector<std::span<const T>> spans;
+    for (std::span<const T> segment : segments()) spans.push_back(segment);
+    spans = sliceSpans(spans, from, to);
+
+    const size_t total = to - from;
+    const size_t workers = workerCount(policy, total);
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>) {
+        return fillParallel<T>(spans, total, workers, [](T* out, const T* in, size_t n) {
+            std::memcpy(static_cast<void*>(out), static_cast<const void*>(in), n * sizeof(T));
+        });
+    } else {
+        return stitchParallel<ResizableArray>(spans, total, workers,
+            [](ResizableArray& out, std::span<const T> segment) { out.append(segment); });
+    }
+}
+
+template<typename T, size_t R>
+template<typename U, typename Policy>
+    requires rarray_exec::execution_policy<Policy>
+ResizableArray<U, R> ResizableArray<T, R>::flatten(Policy&& policy) const {
+    std::vector<std::span<const T>> spans;
+    for (std::span<const T> segment : segments()) spans.push_back(segment);
+
+    // Rozdeľuje sa podľa vonkajších prvkov; dĺžky vnútorných nepoznáme vopred
+    const size_t total = length();
+    return stitchParallel<ResizableArray<U, R>>(spans, total, workerCount(policy, total),
+        [](ResizableArray<U, R>& out, std::span<const T> segment) {
+            for (const auto& inner : segment) {
+                out.append(std::begin(inner), std::end(inner));
+            }
+        });
+}
+
+template<typename T, size_t R>
+template<typename Policy, typename F>
+    requires rarray_exec::execution_policy<Policy>
+void ResizableArray<T, R>::for_each(Policy&& policy, F f) {
+    std::vector<std::span<T>> spans;
+    for (std::span<T> segment : segments()) spans.push_back(segment);
+
+    const size_t total = length();
+    const size_t workers = workerCount(policy, total);
+    const size_t per = (total + workers - 1) / (workers ? workers : 1);
+    runWorkers(workers, [&](size_t w) {
+        const size_t lo = (w * per < total ? w * per : total);
+        const size_t hi = (lo + per < total ? lo + per : total);
+        for (std::span<T> segment : sliceSpans(spans, lo, hi)) {
+            for (T& x : segment) f(x);
+        }
+    });
+}
+
+template<typename T, size_t R>
+template<typename Policy, typename F>
+    requires rarray_exec::execution_policy<Policy>
+ResizableArray<std::decay_t<std::invoke_result_t<F&, const T&>>, R>
+ResizableArray<T, R>::transform(Policy&& policy, F f) const {
+    using U = std::decay_t<std::invoke_result_t<F&, const T&>>;
+
+    std::vector<std::span<const T>> spans;
+    for (std::span<const T> segment : segments()) spans.push_back(segment);
+
+    const size_t total = length();
+    const size_t workers = workerCount(policy, total);
+    if constexpr (std::is_trivially_copyable_v<U> && std::is_trivially_destructible_v<U>) {
+        // výnimka z f zahodí celý výsledok, ničiť nedopísané miesta netreba
+        return fillParallel<U>(spans, total, workers, [&f](U* out, const T* in, size_t n) {
+            for (size_t k = 0; k < n; ++k) ::new (static_cast<void*>(out + k)) U(f(in[k]));
+        });
+    } else {
+        return stitchParallel<ResizableArray<U, R>>(spans, total, workers,
+            [&f](ResizableArray<U, R>& out, std::span<const T> segment) {
+                for (const T& x : segment) out.emplace_back(f(x));
+            });
+    }
 }
\ No newline at end of file
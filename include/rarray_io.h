@@ -0,0 +1,386 @@
+#ifndef PROJEKT_RARRAY_IO_H
+#define PROJEKT_RARRAY_IO_H
+
+// Binárne uloženie ResizableArray a načítanie bez prestavby
+//
+// Formát: FileHeader, n_[0..R) ako uint64_t, potom bloky po úrovniach
+// R-1 ... 1 v poradí indexov. Každý blok má v súbore celú kapacitu B^i
+// (posledný B-blok je doplnený nulami) a začína na násobku 64 bajtov, takže
+// namapovaný súbor sa dá použiť priamo ako bloky poľa.
+//
+//   rarray_io::saveFile(arr, "snap.rarr");
+//   auto copy = rarray_io::loadFile<int, 3>("snap.rarr");      // jedna kópia, bez rebuildu
+//   rarray_io::MappedFile file("snap.rarr");                    // mmap, nič sa nekopíruje
+//   auto mapped = rarray_io::map<int, 3>(file);                 // platí, kým žije file
+//
+//   rarray_io::MappedFile ro("snap.rarr", rarray_io::MappedFile::Mode::ReadOnly);
+//   auto view = rarray_io::mapReadOnly<int, 3>(ro);             // len const prístup
+//
+// Len pre triviálne kopírovateľné T a rovnakú architektúru (veľkosť T,
+// poradie bajtov sa kontroluje). mmap je POSIX.
+
+#include "rarray.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rarray_io {
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t byteOrder; // BYTE_ORDER_TAG tak, ako ho zapísal zapisovateľ
+    uint32_t version;
+    uint64_t elementSize;
+    uint64_t elementAlign;
+    uint64_t levels;    // R
+    uint64_t B;
+    uint64_t length;    // N
+    uint64_t n0;        // prvky v poslednom B-bloku
+};
+
+inline constexpr char     MAGIC[8]       = {'R', 'A', 'R', 'R', 'A', 'Y', '\0', '\0'};
+inline constexpr uint32_t BYTE_ORDER_TAG = 0x01020304u;
+inline constexpr uint32_t VERSION        = 1;
+inline constexpr size_t   ALIGN          = 64; // začiatok dát a každého bloku
+
+namespace detail {
+
+inline size_t alignUp(size_t x) { return (x + ALIGN - 1) & ~(ALIGN - 1); }
+
+template<size_t R>
+size_t headerBytes() { return alignUp(sizeof(FileHeader) + R * sizeof(uint64_t)); }
+
+// Miesto bloku s kapacitou cap v súbore
+template<typename T>
+size_t blockBytes(size_t cap) { return alignUp(cap * sizeof(T)); }
+
+// Overí hlavičku a geometriu, vráti celkovú veľkosť súboru, ktorú popisuje.
+// Pri nezhode hodí std::runtime_error.
+template<typename T, size_t R>
+size_t validate(const FileHeader& h, const uint64_t* n) {
+    auto fail = [](const char* what) { throw std::runtime_error(std::string("rarray_io: ") + what); };
+
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) fail("not a ResizableArray file");
+    if (h.byteOrder != BYTE_ORDER_TAG) fail("byte order mismatch");
+    if (h.version != VERSION) fail("unsupported format version");
+    if (h.elementSize != sizeof(T) || h.elementAlign != alignof(T)) fail("element type mismatch");
+    if (h.levels != R) fail("level count (R) mismatch");
+    if (h.B < 2 || (h.B & (h.B - 1)) != 0) fail("B is not a power of two");
+    // najväčší blok (B^(R-1) prvkov, zarovnaný) aj tabuľky úrovní (2B položiek)
+    // musia byť adresovateľné
+    if (h.B > SIZE_MAX / (4 * sizeof(void*))) fail("B too large");
+    if (n[0] != 0) fail("level 0 must be empty");
+    if (n[1] == 0 ? h.n0 != 0 : (h.n0 == 0 || h.n0 > h.B)) fail("invalid last block size");
+
+    size_t count = 0;
+    size_t bytes = headerBytes<R>();
+    size_t blockSize = 1;
+    for (size_t i = 1; i < R; ++i) {
+        if (blockSize > SIZE_MAX / h.B) fail("block size overflow");
+        blockSize *= h.B;
+        if (blockSize > (SIZE_MAX - ALIGN) / sizeof(T)) fail("block size overflow");
+        if (i + 1 < R && n[i] > 2 * h.B) fail("too many blocks on a lower level");
+        const size_t full = (i == 1 && n[i] > 0 ? n[i] - 1 : n[i]);
+        if (full > 0 && blockSize > (SIZE_MAX - count) / full) fail("length overflow");
+        count += full * blockSize;
+        const size_t perBlock = blockBytes<T>(blockSize);
+        if (n[i] > 0 && perBlock > (SIZE_MAX - bytes) / n[i]) fail("file size overflow");
+        bytes += n[i] * perBlock;
+    }
+    count += h.n0;
+    if (count != h.length) fail("length does not match block counts");
+    // Pole s B drží najviac B^R prvkov (pri N == B^R prestaví až ďalší push_back);
+    // to zároveň obmedzí počet blokov najvyššej úrovne na B
+    if (blockSize <= SIZE_MAX / h.B && h.length > blockSize * h.B) fail("length exceeds B^R");
+    return bytes;
+}
+
+// Koľko bajtov ešte zostáva vo vstupe, ak sa to dá zistiť (inak SIZE_MAX)
+inline size_t remainingBytes(std::istream& in) {
+    std::streambuf* buf = in.rdbuf();
+    const std::streampos here = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    if (here == std::streampos(-1)) return SIZE_MAX;
+    const std::streampos end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    buf->pubseekpos(here, std::ios::in);
+    if (end == std::streampos(-1) || end < here) return SIZE_MAX;
+    return static_cast<size_t>(end - here);
+}
+
+inline void writeZeros(std::ostream& out, size_t bytes) {
+    static const char zeros[ALIGN] = {};
+    while (bytes > 0) {
+        const size_t k = (bytes < ALIGN ? bytes : ALIGN);
+        out.write(zeros, static_cast<std::streamsize>(k));
+        bytes -= k;
+    }
+}
+
+} // namespace detail
+
+// ==================== ULOŽENIE ====================
+
+template<typename T, size_t R>
+void save(const ResizableArray<T, R>& arr, std::ostream& out) {
+    static_assert(std::is_trivially_copyable_v<T>, "rarray_io needs a trivially copyable T");
+    if (arr.rebuildInProgress()) {
+        // ukladá sa jedna geometria: kópia dostane kanonický tvar
+        const ResizableArray<T, R> canonical(arr);
+        save(canonical, out);
+        return;
+    }
+
+    FileHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.byteOrder    = BYTE_ORDER_TAG;
+    h.version      = VERSION;
+    h.elementSize  = sizeof(T);
+    h.elementAlign = alignof(T);
+    h.levels       = R;
+    h.B            = arr.B_;
+    h.length       = arr.N_;
+    h.n0           = arr.n0_;
+
+    uint64_t n[R];
+    for (size_t i = 0; i < R; ++i) n[i] = arr.n_[i];
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(n), sizeof(n));
+    detail::writeZeros(out, detail::headerBytes<R>() - sizeof(h) - sizeof(n));
+
+    for (size_t lvl = R - 1; lvl >= 1; --lvl) {
+        for (size_t j = 0; j < arr.n_[lvl]; ++j) {
+            const auto* block = arr.levels_[lvl].data[j];
+            out.write(reinterpret_cast<const char*>(block->data), static_cast<std::streamsize>(block->size * sizeof(T)));
+            detail::writeZeros(out, detail::blockBytes<T>(block->capacity) - block->size * sizeof(T));
+        }
+    }
+    if (!out) throw std::runtime_error("rarray_io: write failed");
+}
+
+template<typename T, size_t R>
+void saveFile(const ResizableArray<T, R>& arr, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("rarray_io: cannot open " + path + " for writing");
+    save(arr, out);
+    out.close();
+    if (!out) throw std::runtime_error("rarray_io: write failed for " + path);
+}
+
+// ==================== NAČÍTANIE (kópia) ====================
+
+// Postaví rovnakú geometriu ako pri uložení: jedna alokácia a jedno čítanie na blok
+template<typename T, size_t R>
+ResizableArray<T, R> load(std::istream& in, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    static_assert(std::is_trivially_copyable_v<T>, "rarray_io needs a trivially copyable T");
+
+    FileHeader h{};
+    uint64_t n[R];
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    in.read(reinterpret_cast<char*>(n), sizeof(n));
+    if (!in) throw std::runtime_error("rarray_io: truncated header");
+    // Skrátený súbor (ak sa veľkosť vstupu dá zistiť) odmietneme skôr, než sa alokujú bloky
+    const size_t bytes = detail::validate<T, R>(h, n) - sizeof(h) - sizeof(n);
+    if (const size_t left = detail::remainingBytes(in); left != SIZE_MAX && bytes > left) {
+        throw std::runtime_error("rarray_io: truncated block data");
+    }
+    in.ignore(static_cast<std::streamsize>(detail::headerBytes<R>() - sizeof(h) - sizeof(n)));
+
+    ResizableArray<T, R> arr(resource);
+    arr.B_ = h.B;
+    arr.initializeLevels();
+    for (size_t lvl = R - 1; lvl >= 1; --lvl) {
+        arr.levels_[lvl].reserve(n[lvl]);
+        for (size_t j = 0; j < n[lvl]; ++j) {
+            auto* block = arr.acquireBlock(lvl);
+            arr.levels_[lvl].push_back(block);
+            arr.n_[lvl] += 1;
+
+            const size_t used = (lvl == 1 && j + 1 == n[lvl] ? h.n0 : block->capacity);
+            in.read(reinterpret_cast<char*>(block->data), static_cast<std::streamsize>(used * sizeof(T)));
+            if (!in) throw std::runtime_error("rarray_io: truncated block data");
+            block->size = used;
+            in.ignore(static_cast<std::streamsize>(detail::blockBytes<T>(block->capacity) - used * sizeof(T)));
+        }
+    }
+    arr.N_  = h.length;
+    arr.n0_ = h.n0;
+    arr.updateLayout();
+    return arr;
+}
+
+template<typename T, size_t R>
+ResizableArray<T, R> loadFile(const std::string& path,
+                              std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("rarray_io: cannot open " + path);
+    return load<T, R>(in, resource);
+}
+
+// ==================== MMAP (bez kopírovania) ====================
+
+// Namapovaný súbor a zároveň zdroj pamäte pre pole, ktoré nad ním vznikne:
+// bloky v súbore "uvoľní" bez efektu, nové bloky a tabuľky blokov sa berú
+// z upstream. Musí žiť dlhšie než každé pole, ktoré z neho vzniklo.
+class MappedFile : public std::pmr::memory_resource {
+public:
+    enum class Mode {
+        ReadOnly,    // PROT_READ: len cez mapReadOnly() (zápis by skončil SIGSEGV)
+        CopyOnWrite  // MAP_PRIVATE: zmeny idú do súkromných kópií stránok, súbor ostane
+    };
+
+    explicit MappedFile(const std::string& path, Mode mode = Mode::CopyOnWrite,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : mode_(mode), upstream_(upstream) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "rarray_io: open " + path);
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "rarray_io: stat " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ < sizeof(FileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("rarray_io: " + path + " is too small");
+        }
+
+        const int prot = (mode == Mode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE);
+        void* p = ::mmap(nullptr, size_, prot, MAP_PRIVATE, fd, 0);
+        const int err = errno;
+        ::close(fd); // mapovanie platí aj po zatvorení
+        if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), "rarray_io: mmap " + path);
+        base_ = static_cast<std::byte*>(p);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() override { ::munmap(base_, size_); }
+
+    const std::byte* data() const { return base_; }
+    std::byte* data() { return base_; }
+    size_t size() const { return size_; }
+    Mode mode() const { return mode_; }
+
+    bool contains(const void* p) const {
+        const auto* b = static_cast<const std::byte*>(p);
+        return b >= base_ && b < base_ + size_;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override { return upstream_->allocate(bytes, align); }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (contains(p)) return; // blok zo súboru - uvoľní ho až munmap
+        upstream_->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    std::byte* base_ = nullptr;
+    size_t size_ = 0;
+    Mode mode_;
+    std::pmr::memory_resource* upstream_;
+};
+
+namespace detail {
+
+// Prevezme bloky namapovaného súboru do poľa (bez ohľadu na režim súboru)
+template<typename T, size_t R>
+ResizableArray<T, R> mapBlocks(MappedFile& file) {
+    static_assert(std::is_trivially_copyable_v<T>, "rarray_io needs a trivially copyable T");
+    static_assert(alignof(T) <= ALIGN, "blocks in the file are only 64-byte aligned");
+
+    if (file.size() < detail::headerBytes<R>()) throw std::runtime_error("rarray_io: truncated header");
+    FileHeader h{};
+    uint64_t n[R];
+    std::memcpy(&h, file.data(), sizeof(h));
+    std::memcpy(n, file.data() + sizeof(h), sizeof(n));
+    if (detail::validate<T, R>(h, n) > file.size()) throw std::runtime_error("rarray_io: truncated block data");
+
+    using DataBlock = typename ResizableArray<T, R>::DataBlock;
+    ResizableArray<T, R> arr(&file);
+    arr.B_ = h.B;
+    arr.initializeLevels();
+
+    size_t offset = detail::headerBytes<R>();
+    size_t cap = 1;
+    for (size_t i = 1; i < R; ++i) cap *= h.B;
+    for (size_t lvl = R - 1; lvl >= 1; --lvl) {
+        arr.levels_[lvl].reserve(n[lvl]);
+        for (size_t j = 0; j < n[lvl]; ++j) {
+            const size_t used = (lvl == 1 && j + 1 == n[lvl] ? h.n0 : cap);
+            T* mem = reinterpret_cast<T*>(file.data() + offset);
+            arr.levels_[lvl].push_back(new DataBlock(mem, cap, used, &file));
+            arr.n_[lvl] += 1;
+            offset += detail::blockBytes<T>(cap);
+        }
+        cap /= h.B;
+    }
+    arr.N_  = h.length;
+    arr.n0_ = h.n0;
+    arr.updateLayout();
+    return arr;
+}
+
+
+} // namespace detail
+
+// Pole, ktorého bloky sú priamo stránky namapovaného súboru: vytvorí sa
+// v O(počet blokov) bez čítania dát. Funguje normálne (push_back, shrink,
+// set, ...); nové bloky idú z upstream zdroja súboru. Súbor musí byť v režime
+// CopyOnWrite, pre ReadOnly je mapReadOnly().
+template<typename T, size_t R>
+ResizableArray<T, R> map(MappedFile& file) {
+    if (file.mode() == MappedFile::Mode::ReadOnly) {
+        throw std::invalid_argument("rarray_io: map() needs a CopyOnWrite file, use mapReadOnly()");
+    }
+    return detail::mapBlocks<T, R>(file);
+}
+
+// Pole nad súborom dostupné len na čítanie (const ResizableArray), takže zápis
+// do stránok bez PROT_WRITE sa nedá ani skompilovať. Platí, kým žije file.
+template<typename T, size_t R>
+class MappedView {
+public:
+    const ResizableArray<T, R>& operator*() const { return arr_; }
+    const ResizableArray<T, R>* operator->() const { return &arr_; }
+
+    size_t length() const { return arr_.length(); }
+    bool empty() const { return arr_.empty(); }
+    const T& operator[](size_t index) const { return arr_[index]; }
+    const T& get(size_t index) const { return arr_.get(index); }
+    auto begin() const { return arr_.begin(); }
+    auto end() const { return arr_.end(); }
+
+private:
+    template<typename U, size_t S>
+    friend MappedView<U, S> mapReadOnly(MappedFile& file);
+    explicit MappedView(ResizableArray<T, R>&& arr) : arr_(std::move(arr)) {}
+
+    ResizableArray<T, R> arr_;
+};
+
+// Ako map(), ale pre súbor v ľubovoľnom režime a len s const prístupom
+template<typename T, size_t R>
+MappedView<T, R> mapReadOnly(MappedFile& file) {
+    return MappedView<T, R>(detail::mapBlocks<T, R>(file));
+}
+
+} // namespace rarray_io
+
+#endif // PROJEKT_RARRAY_IO_H
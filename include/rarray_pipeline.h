@@ -0,0 +1,344 @@
+#ifndef PROJEKT_RARRAY_PIPELINE_H
+#define PROJEKT_RARRAY_PIPELINE_H
+
+// Lenivé reťazenie filter / flatten / sub nad ResizableArray
+//
+// a.filter(p).flatten<U>().sub_rarray(x, y) postaví celé pole po každom kroku
+// (flatten navyše so všetkými rebuildmi rastúceho výsledku). Tu kroky len
+// opisujú prechod a nič sa nepočíta, kým sa nezavolá to_rarray() alebo
+// for_each():
+//
+//   auto out = rarray_pipe::from(a)
+//                  .filter(p)
+//                  .flatten<U>()
+//                  .sub(x, y)
+//                  .to_rarray();
+//
+// Celý reťazec je jeden prechod po blokoch zdroja bez medzivýsledkov. Každý
+// krok je kurzor s next(), ktorý vráti ukazovateľ na ďalší prvok (priamo do
+// bloku zdroja, resp. do vnútorného rozsahu pri flatten) alebo nullptr na konci.
+//
+// Výsledok: ak je počet vopred známy (bez filter; flatten len so sized
+// vnútornými rozsahmi, spočítajú sa ich veľkosti), pole sa postaví naraz
+// v kanonickom tvare (jedna prestavba, každý prvok sa zapíše raz). Inak sa
+// prvky zbierajú po kusoch CHUNK prvkov a tie sa pridávajú hromadne (append).
+//
+// Reťazec číta zdroj; ten sa nesmie meniť, kým reťazec existuje. Každé
+// vyhodnotenie (to_rarray, for_each, count) prejde zdroj znova, predikát
+// filtra má teda byť bez vedľajších účinkov.
+
+#include "rarray.h"
+
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace rarray_pipe {
+
+// ==================== KROKY (kurzory) ====================
+//
+// Každý krok má:
+//   item_type  - na čo ukazuje next() (const)
+//   value_type - typ prvku výsledného poľa (konštruuje sa z *next())
+//   next()     - ďalší prvok alebo nullptr
+//   skip(n)    - preskočí až n prvkov, vráti koľko preskočil
+//   count()    - počet zvyšných prvkov, ak sa dá zistiť bez vyhodnotenia filtra
+
+// Prvky [from, to) poľa po súvislých kusoch blokov
+template<typename T, size_t R>
+class Source {
+public:
+    using item_type  = const T;
+    using value_type = T;
+
+    Source(const ResizableArray<T, R>& arr, size_t from, size_t to)
+        : seg_(arr.segments().begin()) {
+        if (from > to || to > arr.length()) {
+            throw std::out_of_range("Invalid pipeline range");
+        }
+        advance(from);
+        left_ = to - from;
+    }
+
+    const T* next() {
+        if (left_ == 0) return nullptr;
+        while (cur_ == end_) load();
+        --left_;
+        return cur_++;
+    }
+
+    // O(počet preskočených blokov)
+    size_t skip(size_t n) {
+        const size_t take = (n < left_ ? n : left_);
+        advance(take);
+        left_ -= take;
+        return take;
+    }
+
+    std::optional<size_t> count() const { return left_; }
+
+private:
+    using SegIt = typename ResizableArray<T, R>::template SegmentIterator<true>;
+
+    // Ďalší segment (volá sa, len keď ešte nejaké prvky ostávajú)
+    void load() {
+        const std::span<const T> s = *seg_;
+        ++seg_;
+        cur_ = s.data();
+        end_ = s.data() + s.size();
+    }
+
+    void advance(size_t n) {
+        while (n > 0) {
+            if (cur_ == end_) load();
+            const size_t avail = static_cast<size_t>(end_ - cur_);
+            const size_t take = (avail < n ? avail : n);
+            cur_ += take;
+            n -= take;
+        }
+    }
+
+    SegIt seg_;    // ďalší nenačítaný segment
+    const T* cur_ = nullptr;
+    const T* end_ = nullptr;
+    size_t left_ = 0;
+};
+
+// Prvky, ktoré spĺňajú pred
+template<typename Up, typename Pred>
+class FilterStage {
+public:
+    using item_type  = typename Up::item_type;
+    using value_type = typename Up::value_type;
+
+    FilterStage(Up up, Pred pred) : up_(std::move(up)), pred_(std::move(pred)) {}
+
+    item_type* next() {
+        while (item_type* p = up_.next()) {
+            if (pred_(*p)) return p;
+        }
+        return nullptr;
+    }
+
+    size_t skip(size_t n) {
+        size_t done = 0;
+        while (done < n && next()) ++done;
+        return done;
+    }
+
+    std::optional<size_t> count() const { return std::nullopt; }
+
+private:
+    Up up_;
+    Pred pred_;
+};
+
+// Prvky vnútorných rozsahov za sebou; prvky výsledku sú U (skonštruované z prvkov rozsahov)
+template<typename U, typename Up>
+class FlattenStage {
+    using Outer = typename Up::item_type; // const vnútorný rozsah
+    using InnerIt = decltype(std::ranges::begin(std::declval<Outer&>()));
+    static_assert(std::is_lvalue_reference_v<std::iter_reference_t<InnerIt>>,
+                  "flatten needs inner ranges whose elements are lvalues");
+
+public:
+    using item_type  = std::remove_reference_t<std::iter_reference_t<InnerIt>>;
+    using value_type = U;
+
+    explicit FlattenStage(Up up) : up_(std::move(up)) {}
+
+    item_type* next() {
+        while (!outer_ || it_ == end_) {
+            outer_ = up_.next();
+            if (!outer_) return nullptr;
+            it_ = std::ranges::begin(*outer_);
+            end_ = std::ranges::end(*outer_);
+        }
+        item_type* p = std::addressof(*it_);
+        ++it_;
+        return p;
+    }
+
+    size_t skip(size_t n) {
+        size_t done = 0;
+        while (done < n && next()) ++done;
+        return done;
+    }
+
+    // Súčet veľkostí vnútorných rozsahov (prejde vonkajšie prvky na kópii kurzora)
+    std::optional<size_t> count() const {
+        if constexpr (std::ranges::sized_range<Outer>) {
+            if (!up_.count()) return std::nullopt;
+            size_t total = 0;
+            if (outer_) total += static_cast<size_t>(std::ranges::distance(it_, end_));
+            Up probe = up_;
+            while (Outer* p = probe.next()) total += static_cast<size_t>(std::ranges::size(*p));
+            return total;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+private:
+    Up up_;
+    Outer* outer_ = nullptr;
+    InnerIt it_{};
+    InnerIt end_{};
+};
+
+// Prvky [from, to) prúdu
+template<typename Up>
+class SubStage {
+public:
+    using item_type  = typename Up::item_type;
+    using value_type = typename Up::value_type;
+
+    SubStage(Up up, size_t from, size_t to) : up_(std::move(up)), from_(from), left_(to - from) {
+        if (from > to) throw std::out_of_range("Invalid pipeline range");
+        if (auto n = up_.count(); n && to > *n) throw std::out_of_range("Invalid pipeline range");
+    }
+
+    item_type* next() {
+        if (!skipped_) skipFront();
+        if (left_ == 0) return nullptr;
+        item_type* p = up_.next();
+        if (!p) throw std::out_of_range("Invalid pipeline range"); // prúd bol kratší než to
+        --left_;
+        return p;
+    }
+
+    size_t skip(size_t n) {
+        if (!skipped_) skipFront();
+        const size_t done = up_.skip(n < left_ ? n : left_);
+        left_ -= done;
+        return done;
+    }
+
+    std::optional<size_t> count() const {
+        if (up_.count()) return left_;
+        return std::nullopt;
+    }
+
+private:
+    void skipFront() {
+        skipped_ = true;
+        if (up_.skip(from_) < from_) throw std::out_of_range("Invalid pipeline range");
+    }
+
+    Up up_;
+    size_t from_;
+    size_t left_;
+    bool skipped_ = false;
+};
+
+// ==================== REŤAZEC ====================
+
+template<typename Stage, size_t R>
+class Pipeline {
+public:
+    using value_type = typename Stage::value_type;
+
+    // Koľko prvkov sa pri neznámom počte zbiera pred jedným hromadným append
+    static constexpr size_t CHUNK = 1024;
+
+    explicit Pipeline(Stage stage) : stage_(std::move(stage)) {}
+
+    template<typename Pred>
+    Pipeline<FilterStage<Stage, Pred>, R> filter(Pred pred) const {
+        return Pipeline<FilterStage<Stage, Pred>, R>(FilterStage<Stage, Pred>(stage_, std::move(pred)));
+    }
+
+    template<typename U>
+    Pipeline<FlattenStage<U, Stage>, R> flatten() const {
+        return Pipeline<FlattenStage<U, Stage>, R>(FlattenStage<U, Stage>(stage_));
+    }
+
+    // Ako sub_rarray(from, to); pri neznámom počte sa zlý rozsah zistí až pri vyhodnotení
+    Pipeline<SubStage<Stage>, R> sub(size_t from, size_t to) const {
+        return Pipeline<SubStage<Stage>, R>(SubStage<Stage>(stage_, from, to));
+    }
+
+    // f(const item&) pre každý prvok, bez výsledného poľa
+    template<typename F>
+    void for_each(F f) const {
+        Stage s = stage_;
+        while (auto* p = s.next()) f(*p);
+    }
+
+    // Počet prvkov (vyhodnotí reťazec, ak ho nevie zistiť inak)
+    size_t count() const {
+        if (auto n = stage_.count()) return *n;
+        Stage s = stage_;
+        size_t n = 0;
+        while (s.next()) ++n;
+        return n;
+    }
+
+    ResizableArray<value_type, R> to_rarray(
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+        using U = value_type;
+        ResizableArray<U, R> out(resource);
+        Stage s = stage_;
+
+        if (auto n = s.count()) {
+            // Počet je známy: jedna stavba kanonickej geometrie, prvky rovno do blokov
+            out.appendCounted(*n, [&](U* dst, size_t k) {
+                size_t i = 0;
+                try {
+                    for (; i < k; ++i) std::construct_at(dst + i, *s.next());
+                } catch (...) {
+                    std::destroy(dst, dst + i); // appendCounted berie kus ako celok
+                    throw;
+                }
+            });
+            return out;
+        }
+
+        // Neznámy počet: po kusoch, každý kus jedným hromadným append
+        std::allocator<U> alloc;
+        U* buf = alloc.allocate(CHUNK);
+        size_t got = 0;
+        auto flush = [&] {
+            out.append(std::make_move_iterator(buf), std::make_move_iterator(buf + got));
+            std::destroy_n(buf, got);
+            got = 0;
+        };
+        try {
+            while (auto* p = s.next()) {
+                std::construct_at(buf + got, *p);
+                if (++got == CHUNK) flush();
+            }
+            if (got > 0) flush();
+        } catch (...) {
+            std::destroy_n(buf, got);
+            alloc.deallocate(buf, CHUNK);
+            throw;
+        }
+        alloc.deallocate(buf, CHUNK);
+        return out;
+    }
+
+private:
+    Stage stage_;
+};
+
+// ==================== ZAČIATOK REŤAZCA ====================
+
+template<typename T, size_t R>
+Pipeline<Source<T, R>, R> from(const ResizableArray<T, R>& arr) {
+    return Pipeline<Source<T, R>, R>(Source<T, R>(arr, 0, arr.length()));
+}
+
+template<typename T, size_t R>
+Pipeline<Source<T, R>, R> from(const ResizableArray<T, R>& arr, size_t first, size_t last) {
+    return Pipeline<Source<T, R>, R>(Source<T, R>(arr, first, last));
+}
+
+} // namespace rarray_pipe
+
+#endif // PROJEKT_RARRAY_PIPELINE_H
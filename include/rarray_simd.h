@@ -0,0 +1,185 @@
+#ifndef PROJEKT_RARRAY_SIMD_H
+#define PROJEKT_RARRAY_SIMD_H
+
+// SIMD pomocné funkcie pre ResizableArray
+// Každá funkcia má AVX2 a NEON verziu (podľa toho, s čím sa kompiluje)
+// a skalárnu verziu, ktorá dorieši zvyšok a beží všade inde.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RARRAY_SIMD_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define RARRAY_SIMD_NEON 1
+#endif
+
+// Softvérový prefetch (na iných kompilátoroch nerobí nič)
+#if defined(__GNUC__) || defined(__clang__)
+#define RARRAY_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define RARRAY_PREFETCH(addr) ((void)(addr))
+#endif
+
+namespace rarray_detail {
+
+// lvl[k] = 1 + počet j z [0, M), pre ktoré idx[k] < bounds[j]
+// (bounds sú začiatky úrovní 1..M, klesajúce, takže výsledok je úroveň indexu)
+// Pre indexy >= 2^63 je výsledok vo vektorovej verzii nezmyselný - volajúci
+// ich musí vyradiť kontrolou hraníc skôr, než výsledok použije.
+template<size_t M>
+inline void levelsOf(const size_t* idx, size_t n, const size_t* bounds, size_t* lvl) {
+    size_t k = 0;
+    if constexpr (M > 0 && sizeof(size_t) == 8) {
+#if defined(RARRAY_SIMD_AVX2)
+        __m256i b[M];
+        for (size_t j = 0; j < M; ++j) b[j] = _mm256_set1_epi64x(static_cast<long long>(bounds[j]));
+        for (; k + 4 <= n; k += 4) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + k));
+            __m256i acc = _mm256_set1_epi64x(1);
+            // porovnanie dáva -1 (všetky bity) tam, kde bounds[j] > idx
+            for (size_t j = 0; j < M; ++j) acc = _mm256_sub_epi64(acc, _mm256_cmpgt_epi64(b[j], v));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lvl + k), acc);
+        }
+#elif defined(RARRAY_SIMD_NEON)
+        uint64x2_t b[M];
+        for (size_t j = 0; j < M; ++j) b[j] = vdupq_n_u64(bounds[j]);
+        for (; k + 2 <= n; k += 2) {
+            const uint64x2_t v = vld1q_u64(reinterpret_cast<const uint64_t*>(idx + k));
+            uint64x2_t acc = vdupq_n_u64(1);
+            for (size_t j = 0; j < M; ++j) acc = vsubq_u64(acc, vcgtq_u64(b[j], v));
+            vst1q_u64(reinterpret_cast<uint64_t*>(lvl + k), acc);
+        }
+#endif
+    }
+    for (; k < n; ++k) {
+        size_t l = 1;
+        for (size_t j = 0; j < M; ++j) l += static_cast<size_t>(idx[k] < bounds[j]);
+        lvl[k] = l;
+    }
+}
+
+// ==================== COMPRESS (pre filter) ====================
+
+#if defined(RARRAY_SIMD_AVX2)
+// Pre masku m (8 bitov) permutácia, ktorá posunie vybrané 32-bitové pruhy na začiatok
+struct CompressTable32 {
+    alignas(32) int32_t idx[256][8];
+    constexpr CompressTable32() : idx{} {
+        for (int m = 0; m < 256; ++m) {
+            int p = 0;
+            for (int j = 0; j < 8; ++j)
+                if (m & (1 << j)) idx[m][p++] = j;
+            for (; p < 8; ++p) idx[m][p] = 0;
+        }
+    }
+};
+inline constexpr CompressTable32 compressTable32{};
+#endif
+
+// Skopíruje prvky src[0..n), ktoré spĺňajú pred, na začiatok dst; vráti ich počet.
+// dst musí mať miesto na n prvkov (zapisuje sa aj na pozície, ktoré sa hneď
+// prepíšu), preto len pre triviálne kopírovateľné T. Bez podmienených skokov:
+// pre 4- a 8-bajtové aritmetické T s AVX2 sa ukladá 8 (4) pruhov naraz.
+template<typename T, typename Pred>
+inline size_t compress(const T* src, size_t n, T* dst, Pred& pred) {
+    size_t pos = 0;
+    size_t k = 0;
+#if defined(RARRAY_SIMD_AVX2)
+    if constexpr (std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+        constexpr size_t LANES = 32 / sizeof(T);
+        for (; k + LANES <= n; k += LANES) {
+            unsigned mask = 0;
+            for (size_t j = 0; j < LANES; ++j)
+                mask |= static_cast<unsigned>(static_cast<bool>(pred(src[k + j]))) << j;
+
+            // 8-bajtový pruh = dva 32-bitové, masku teda "zdvojíme"
+            unsigned m32 = mask;
+            if constexpr (sizeof(T) == 8) {
+                m32 = 0;
+                for (size_t j = 0; j < 4; ++j)
+                    if (mask & (1u << j)) m32 |= 3u << (2 * j);
+            }
+            const __m256i v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k));
+            const __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(compressTable32.idx[m32]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + pos), _mm256_permutevar8x32_epi32(v, perm));
+            pos += static_cast<size_t>(std::popcount(mask));
+        }
+    }
+#endif
+    for (; k < n; ++k) {
+        dst[pos] = src[k];
+        pos += static_cast<size_t>(static_cast<bool>(pred(src[k])));
+    }
+    return pos;
+}
+
+// ==================== REDUKCIE ====================
+// Viac nezávislých akumulátorov: bez závislosti medzi iteráciami ich kompilátor
+// zvektorizuje (SSE/AVX2/NEON podľa cieľa) a aj skalárne sa prekrývajú.
+
+template<typename T>
+inline T sumSpan(const T* p, size_t n) {
+    T a0{}, a1{}, a2{}, a3{};
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        a0 += p[k];
+        a1 += p[k + 1];
+        a2 += p[k + 2];
+        a3 += p[k + 3];
+    }
+    for (; k < n; ++k) a0 += p[k];
+    return (a0 + a1) + (a2 + a3);
+}
+
+// Minimum (Max = false) alebo maximum (Max = true) neprázdneho úseku
+template<bool Max, typename T>
+inline T extremeSpan(const T* p, size_t n) {
+    auto pick = [](const T& a, const T& b) -> const T& {
+        if constexpr (Max) return (a < b ? b : a);
+        else return (b < a ? b : a);
+    };
+    T a0 = p[0], a1 = p[0], a2 = p[0], a3 = p[0];
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        a0 = pick(a0, p[k]);
+        a1 = pick(a1, p[k + 1]);
+        a2 = pick(a2, p[k + 2]);
+        a3 = pick(a3, p[k + 3]);
+    }
+    for (; k < n; ++k) a0 = pick(a0, p[k]);
+    return pick(pick(a0, a1), pick(a2, a3));
+}
+
+template<typename T, typename Pred>
+inline size_t countSpan(const T* p, size_t n, Pred& pred) {
+    size_t c = 0;
+    for (size_t k = 0; k < n; ++k) c += static_cast<size_t>(static_cast<bool>(pred(p[k])));
+    return c;
+}
+
+// Pozícia prvého prvku rovného value, alebo n. Hľadá po 16-prvkových kúskoch
+// bez skoku vo vnútri kúska (porovnania sa zvektorizujú), skáče sa až na konci.
+template<typename T>
+inline size_t findSpan(const T* p, size_t n, const T& value) {
+    constexpr size_t CHUNK = 16;
+    size_t k = 0;
+    if constexpr (std::is_arithmetic_v<T>) {
+        for (; k + CHUNK <= n; k += CHUNK) {
+            bool any = false;
+            for (size_t j = 0; j < CHUNK; ++j) any |= (p[k + j] == value);
+            if (any) break;
+        }
+    }
+    for (; k < n; ++k)
+        if (p[k] == value) return k;
+    return n;
+}
+
+} // namespace rarray_detail
+
+#endif // PROJEKT_RARRAY_SIMD_H
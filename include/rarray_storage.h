@@ -0,0 +1,250 @@
+#ifndef PROJEKT_RARRAY_STORAGE_H
+#define PROJEKT_RARRAY_STORAGE_H
+
+// Zdroje pamäte pre veľké bloky (používajú sa cez setLargeBlockResource)
+//
+// FileBackedResource - bloky v súbore, pre polia väčšie než RAM
+// HugePageResource   - bloky na veľkých stránkach (menej TLB missov)
+//
+// ==================== FileBackedResource ====================
+//
+// FileBackedResource je std::pmr::memory_resource, ktorý každú (dostatočne
+// veľkú) alokáciu namapuje ako samostatný úsek jedného pracovného súboru
+// (MAP_SHARED). Stránky potom do RAM načítava a späť zapisuje jadro podľa
+// prístupu - page cache je tu LRU cache blokov. Hierarchia B, B^2, B^3 sa
+// dobre hodí na I/O: veľké bloky sú dlhé súvislé úseky súboru.
+//
+//   FileBackedResource disk("/mnt/scratch");
+//   ResizableArray<double> arr;
+//   arr.setLargeBlockResource(2, &disk);  // B^2, B^3, ... na disku, B-bloky v RAM
+//
+// Súbor je hneď po vytvorení odstránený z adresára (O_TMPFILE alebo unlink),
+// takže po skončení procesu nič neostane. Uvoľnené úseky sa použijú znova pre
+// rovnako veľké alokácie a ich miesto na disku sa vráti (FALLOC_FL_PUNCH_HOLE).
+// Alokácie menšie než minBytes idú do upstream. Nie je synchronizovaný
+// (ako std::pmr::unsynchronized_pool_resource). Len POSIX (Linux).
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace rarray_storage {
+
+class FileBackedResource : public std::pmr::memory_resource {
+public:
+    // dir: adresár pre pracovný súbor; minBytes: menšie alokácie idú do upstream
+    explicit FileBackedResource(const std::string& dir = "/tmp", size_t minBytes = 64 * 1024,
+                                std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : minBytes_(minBytes), upstream_(upstream),
+          page_(static_cast<size_t>(::sysconf(_SC_PAGESIZE))) {
+#ifdef O_TMPFILE
+        fd_ = ::open(dir.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+#endif
+        if (fd_ < 0) {
+            std::string path = dir + "/rarray-XXXXXX";
+            fd_ = ::mkstemp(path.data());
+            if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "FileBackedResource: " + dir);
+            ::unlink(path.c_str());
+        }
+    }
+
+    FileBackedResource(const FileBackedResource&) = delete;
+    FileBackedResource& operator=(const FileBackedResource&) = delete;
+
+    // Všetky polia, ktoré odtiaľto alokujú, musia zaniknúť skôr
+    ~FileBackedResource() override {
+        for (auto& [ptr, extent] : live_) ::munmap(ptr, extent.bytes);
+        ::close(fd_);
+    }
+
+    // Koľko bajtov je práve namapovaných (živé bloky)
+    size_t mappedBytes() const { return mapped_; }
+    // Veľkosť pracovného súboru (aj s voľnými úsekmi)
+    size_t fileBytes() const { return fileEnd_; }
+    size_t minBytes() const { return minBytes_; }
+
+    // Je p začiatkom bloku v súbore?
+    bool owns(const void* p) const { return live_.count(const_cast<void*>(p)) != 0; }
+
+private:
+    struct Extent {
+        off_t offset;
+        size_t bytes;
+    };
+
+    size_t roundToPage(size_t bytes) const { return (bytes + page_ - 1) / page_ * page_; }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (bytes < minBytes_ || alignment > page_) return upstream_->allocate(bytes, alignment);
+
+        const size_t len = roundToPage(bytes);
+        Extent extent{};
+        if (auto it = free_.find(len); it != free_.end()) {
+            extent = {it->second, len};
+            free_.erase(it);
+        } else {
+            extent = {static_cast<off_t>(fileEnd_), len};
+            if (::ftruncate(fd_, static_cast<off_t>(fileEnd_ + len)) != 0) throw std::bad_alloc();
+            fileEnd_ += len;
+        }
+
+        void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, extent.offset);
+        if (p == MAP_FAILED) {
+            free_.emplace(len, extent.offset);
+            throw std::bad_alloc();
+        }
+        live_.emplace(p, extent);
+        mapped_ += len;
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        auto it = live_.find(p);
+        if (it == live_.end()) {
+            upstream_->deallocate(p, bytes, alignment);
+            return;
+        }
+        const Extent extent = it->second;
+        live_.erase(it);
+        ::munmap(p, extent.bytes);
+        mapped_ -= extent.bytes;
+#ifdef FALLOC_FL_PUNCH_HOLE
+        // obsah už netreba: vrátiť miesto na disku (veľkosť súboru sa nemení)
+        ::fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, extent.offset,
+                    static_cast<off_t>(extent.bytes));
+#endif
+        free_.emplace(extent.bytes, extent.offset);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    int fd_ = -1;
+    size_t minBytes_;
+    std::pmr::memory_resource* upstream_;
+    size_t page_;
+
+    size_t fileEnd_ = 0;
+    size_t mapped_ = 0;
+    std::unordered_map<void*, Extent> live_;  // namapované bloky
+    std::multimap<size_t, off_t> free_;       // voľné úseky súboru podľa veľkosti
+};
+
+// ==================== HugePageResource ====================
+//
+// Alokácie od minBytes vyššie dostanú vlastné anonymné mapovanie zarovnané na
+// veľkú stránku (2 MB alebo 1 GB) a zaokrúhlené na jej násobok:
+//  - Mode::Transparent: mmap + madvise(MADV_HUGEPAGE), jadro (THP) stránky
+//    zlúči, keď môže;
+//  - Mode::Explicit: MAP_HUGETLB z rezervovaných stránok (vm.nr_hugepages);
+//    ak nie sú, použije sa Transparent.
+// Menšie alokácie (B-bloky, tabuľky) idú bez zmeny do upstream; či alokácia
+// patrí sem, určuje len jej veľkosť. Len Linux.
+//
+//   HugePageResource huge;
+//   arr.setLargeBlockResource(R - 1, &huge);  // najväčšie bloky na 2 MB stránkach
+
+class HugePageResource : public std::pmr::memory_resource {
+public:
+    enum class Mode { Transparent, Explicit };
+
+    static constexpr size_t PAGE_2M = size_t{2} << 20;
+    static constexpr size_t PAGE_1G = size_t{1} << 30;
+
+    explicit HugePageResource(Mode mode = Mode::Transparent, size_t pageBytes = PAGE_2M, size_t minBytes = 0,
+                              std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : mode_(mode), page_(pageBytes), minBytes_(minBytes ? minBytes : pageBytes), upstream_(upstream) {
+        if (pageBytes != PAGE_2M && pageBytes != PAGE_1G) {
+            throw std::invalid_argument("HugePageResource: page size must be 2 MB or 1 GB");
+        }
+    }
+
+    HugePageResource(const HugePageResource&) = delete;
+    HugePageResource& operator=(const HugePageResource&) = delete;
+
+    size_t pageBytes() const { return page_; }
+    size_t minBytes() const { return minBytes_; }
+    size_t mappedBytes() const { return mapped_; }
+    // Koľko živých alokácií je z rezervovaných (hugetlb) stránok
+    size_t hugetlbAllocations() const { return hugetlb_; }
+
+private:
+    size_t roundToPage(size_t bytes) const { return (bytes + page_ - 1) / page_ * page_; }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (bytes < minBytes_ || alignment > page_) return upstream_->allocate(bytes, alignment);
+        const size_t len = roundToPage(bytes);
+
+#ifdef MAP_HUGETLB
+        if (mode_ == Mode::Explicit) {
+            const int sizeFlag = (page_ == PAGE_1G ? (30 << MAP_HUGE_SHIFT) : (21 << MAP_HUGE_SHIFT));
+            void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | sizeFlag, -1, 0);
+            if (p != MAP_FAILED) {
+                // Záznam (môže alokovať) skôr než počítadlá, aby chyba nenechala mapovanie visieť
+                try {
+                    explicit_.emplace(p);
+                } catch (...) {
+                    ::munmap(p, len);
+                    throw;
+                }
+                mapped_ += len;
+                ++hugetlb_;
+                return p;
+            }
+        }
+#endif
+        // Zarovnanie na veľkú stránku: namapovať o stránku viac a okraje vrátiť
+        void* raw = ::mmap(nullptr, len + page_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        const auto base = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (base + page_ - 1) & ~(uintptr_t{page_} - 1);
+        if (aligned > base) ::munmap(raw, aligned - base);
+        if (const size_t tail = (base + len + page_) - (aligned + len); tail > 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + len), tail);
+        }
+        void* p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        ::madvise(p, len, MADV_HUGEPAGE); // len rada; bez THP ostanú bežné stránky
+#endif
+        mapped_ += len;
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if (bytes < minBytes_ || alignment > page_) {
+            upstream_->deallocate(p, bytes, alignment);
+            return;
+        }
+        const size_t len = roundToPage(bytes);
+        if (explicit_.erase(p)) --hugetlb_;
+        ::munmap(p, len);
+        mapped_ -= len;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Mode mode_;
+    size_t page_;
+    size_t minBytes_;
+    std::pmr::memory_resource* upstream_;
+
+    size_t mapped_ = 0;
+    size_t hugetlb_ = 0;
+    std::unordered_set<void*> explicit_; // alokácie z hugetlb (len pre počítadlo)
+};
+
+} // namespace rarray_storage
+
+#endif // PROJEKT_RARRAY_STORAGE_H
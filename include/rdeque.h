@@ -0,0 +1,261 @@
+#ifndef PROJEKT_RDEQUE_H
+#define PROJEKT_RDEQUE_H
+
+// Obojstranná verzia ResizableArray: push/pop na oboch koncoch
+//
+// Deque sú dve ResizableArray "chrbtom k sebe": front_ drží začiatok v
+// opačnom poradí (jeho posledný prvok je prvý prvok deque), back_ zvyšok.
+// Každá polovica má vlastnú úrovňovú štruktúru (levels_, n_, n0_), vlastný
+// čiastočný B-blok na konci a vlastné combineBlocks/splitBlocks, takže
+// push_front/pop_front robia na začiatku presne to, čo push_back/shrink na
+// konci - amortizovane O(r).
+//
+// Keď sa pri pop jedna polovica vyprázdni, presunie sa do nej polovica
+// druhej (O(N), ale ďalšie také vyrovnanie príde najskôr po N/2 operáciách,
+// takže amortizovane O(1)). Pamäť: N + O(N^(1/r)), lebo každá polovica spĺňa
+// ten istý odhad a pri T s nehádžucim presunom sa vyrovnáva na mieste.
+//
+// Indexovanie je O(1): index < front_.length() ide do front_, inak do back_.
+
+#include "rarray.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template<typename T, size_t R = 3>
+class RDeque {
+    using Half = ResizableArray<T, R>;
+
+public:
+    using value_type = T;
+    using size_type  = size_t;
+
+    RDeque() = default;
+    explicit RDeque(std::pmr::memory_resource* resource) : front_(resource), back_(resource) {}
+
+    // ==================== VEĽKOSŤ ====================
+
+    size_t length() const { return front_.length() + back_.length(); }
+    size_t size() const { return length(); }
+    bool empty() const { return front_.empty() && back_.empty(); }
+
+    // ==================== PRÍSTUP ====================
+
+    T& operator[](size_t index) { return at(index); }
+    const T& operator[](size_t index) const { return const_cast<RDeque*>(this)->at(index); }
+
+    T& get(size_t index) {
+        if (index >= length()) throw std::out_of_range("get: index out of range");
+        return at(index);
+    }
+    const T& get(size_t index) const {
+        if (index >= length()) throw std::out_of_range("get: index out of range");
+        return const_cast<RDeque*>(this)->at(index);
+    }
+
+    void set(size_t index, const T& item) { get(index) = item; }
+    void set(size_t index, T&& item) { get(index) = std::move(item); }
+
+    T& front() {
+        if (empty()) throw std::out_of_range("front on empty deque");
+        return at(0);
+    }
+    const T& front() const { return const_cast<RDeque*>(this)->front(); }
+
+    T& back() {
+        if (empty()) throw std::out_of_range("back on empty deque");
+        return at(length() - 1);
+    }
+    const T& back() const { return const_cast<RDeque*>(this)->back(); }
+
+    // ==================== ÚPRAVY ====================
+
+    void push_back(const T& item) { back_.push_back(item); }
+    void push_back(T&& item) { back_.push_back(std::move(item)); }
+    template<typename... Args>
+    T& emplace_back(Args&&... args) { return back_.emplace_back(std::forward<Args>(args)...); }
+
+    void push_front(const T& item) { front_.push_back(item); }
+    void push_front(T&& item) { front_.push_back(std::move(item)); }
+    template<typename... Args>
+    T& emplace_front(Args&&... args) { return front_.emplace_back(std::forward<Args>(args)...); }
+
+    void pop_back() {
+        if (empty()) throw std::out_of_range("pop_back on empty deque");
+        if (back_.empty()) rebalance(front_, back_);
+        back_.shrink();
+    }
+
+    void pop_front() {
+        if (empty()) throw std::out_of_range("pop_front on empty deque");
+        if (front_.empty()) rebalance(back_, front_);
+        front_.shrink();
+    }
+
+    void clear() {
+        front_ = Half(front_.resource());
+        back_  = Half(back_.resource());
+    }
+
+    // ==================== ITERÁTORY ====================
+
+    template<bool Const>
+    class Iter {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using owner_type        = std::conditional_t<Const, const RDeque, RDeque>;
+
+        Iter() = default;
+        Iter(owner_type* owner, size_t index) : owner_(owner), index_(index) {}
+        // iterator -> const_iterator
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        Iter(const Iter<false>& other) : owner_(other.owner_), index_(other.index_) {}
+
+        reference operator*() const { return (*owner_)[index_]; }
+        pointer operator->() const { return &(*owner_)[index_]; }
+        reference operator[](difference_type n) const { return (*owner_)[index_ + n]; }
+
+        Iter& operator++() { ++index_; return *this; }
+        Iter operator++(int) { Iter t = *this; ++index_; return t; }
+        Iter& operator--() { --index_; return *this; }
+        Iter operator--(int) { Iter t = *this; --index_; return t; }
+        Iter& operator+=(difference_type n) { index_ += n; return *this; }
+        Iter& operator-=(difference_type n) { index_ -= n; return *this; }
+        friend Iter operator+(Iter it, difference_type n) { return it += n; }
+        friend Iter operator+(difference_type n, Iter it) { return it += n; }
+        friend Iter operator-(Iter it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const Iter& a, const Iter& b) {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const Iter& a, const Iter& b) { return a.index_ == b.index_; }
+        friend auto operator<=>(const Iter& a, const Iter& b) { return a.index_ <=> b.index_; }
+
+    private:
+        friend class Iter<!Const>;
+        owner_type* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator       = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, length()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, length()); }
+
+    // Obidve polovice (na testy a ladenie): front_ je v opačnom poradí
+    const Half& frontHalf() const { return front_; }
+    const Half& backHalf() const { return back_; }
+
+private:
+    T& at(size_t index) {
+        const size_t f = front_.length();
+        return index < f ? front_.get_unchecked(f - 1 - index) : back_.get_unchecked(index - f);
+    }
+
+    // to je prázdna: presunie do nej bližšiu polovicu prvkov from (aspoň jeden).
+    // Prvky from sú v poradí "od stredu deque", preto bližšie k to sú tie na začiatku from.
+    // Pri výnimke ostane deque nezmenený.
+    static void rebalance(Half& from, Half& to) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
+            rebalanceInPlace(from, to);
+        } else {
+            rebalanceByCopy(from, to);
+        }
+    }
+
+    // Bez druhej kópie: from sa na mieste preusporiada tak, aby presúvané prvky
+    // boli na konci v opačnom poradí, a po jednom prechádzajú z konca from na koniec
+    // to. Každý odobratý prvok from hneď uvoľní (shrink), takže pamäť ostáva
+    // N + O(blok). Hádzať môžu len alokácie (nový blok to, rozbitie bloku from);
+    // vtedy sa obidve polovice preusporiadajú späť. Výnimkou je zlyhaný rebuild
+    // from pri (B/4)^r, ktorý ju ako každý rebuild() vyprázdni.
+    static void rebalanceInPlace(Half& from, Half& to) {
+        const size_t n = from.length();
+        const size_t k = (n + 1) / 2;
+
+        // to dostane B, pri ktorom k prvkov nespustí rebuild (pri chybe by to vyprázdnil)
+        size_t b = to.B_;
+        while (to.power(b, R) < k) b *= 2;
+        if (b != to.B_) to.rebuild(b);
+
+        // from = [from[k], ..., from[n-1], from[k-1], ..., from[0]]
+        const auto mid = from.begin() + static_cast<std::ptrdiff_t>(k);
+        std::reverse(from.begin(), mid);
+        std::rotate(from.begin(), mid, from.end());
+
+        size_t moved = 0;
+        try {
+            for (; moved < k; ++moved) {
+                to.prepareBack();
+                T& last = from.get_unchecked(n - 1 - moved);
+                T item(std::move(last));
+                try {
+                    from.shrink();
+                } catch (...) {
+                    if (from.length() == n - moved) last = std::move(item);
+                    to.dropEmptyTail();
+                    throw;
+                }
+                to.placeBack(std::move(item));
+            }
+        } catch (...) {
+            // to = [from[0], ..., from[moved-1]], koniec from = from[k-1], ..., from[moved]
+            std::reverse(to.begin(), to.end());
+            if (from.length() == n - moved) {
+                const auto rest = from.begin() + static_cast<std::ptrdiff_t>(n - k);
+                std::reverse(rest, from.end());
+                std::rotate(from.begin(), rest, from.end());
+            }
+            throw;
+        }
+        std::reverse(to.begin(), to.end());
+    }
+
+    // Presun T môže hádzať: obe nové polovice sa vyrobia vedľa starých kópiou
+    // (ak sa T nedá kopírovať, presunom ako v relocateElements) a vymenia sa až na
+    // konci, za cenu 2N pamäte počas vyrovnania.
+    static void rebalanceByCopy(Half& from, Half& to) {
+        const size_t n = from.length();
+        const size_t k = (n + 1) / 2;
+        Half nearHalf(to.resource());
+        Half farHalf(from.resource());
+        appendEach(nearHalf, k, [&](size_t i) -> T& { return from.get_unchecked(k - 1 - i); });
+        appendEach(farHalf, n - k, [&](size_t i) -> T& { return from.get_unchecked(k + i); });
+        to = std::move(nearHalf);
+        from = std::move(farHalf);
+    }
+
+    // Pridá na koniec dst prvky src(0), ..., src(count-1) (presun len ak nehádže)
+    template<typename Src>
+    static void appendEach(Half& dst, size_t count, Src src) {
+        size_t next = 0;
+        dst.appendCounted(count, [&](T* out, size_t chunk) {
+            size_t i = 0;
+            try {
+                for (; i < chunk; ++i) std::construct_at(out + i, std::move_if_noexcept(src(next + i)));
+            } catch (...) {
+                std::destroy(out, out + i);
+                throw;
+            }
+            next += chunk;
+        });
+    }
+
+    Half front_; // prvky [0, front_.length()) v opačnom poradí
+    Half back_;  // prvky [front_.length(), length())
+};
+
+#endif // PROJEKT_RDEQUE_H
@@ -1,7 +1,24 @@
 #include <gtest/gtest.h>
 #include "../include/rarray.h"
 #include "../include/rarray_impl.tpp"
+#include "../include/rarray_concurrent.h"
+#include "../include/rarray_io.h"
+#include "../include/rarray_storage.h"
+#include "../include/rarray_pipeline.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
 #include <new>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <utility>
 
 
@@ -22,6 +39,51 @@ TEST(DataBlockTest, AllocationAndMove) {
     EXPECT_EQ(block.data, nullptr);
 }
 
+// Počíta živé inštancie - overuje, že bloky konštruujú len skutočné prvky
+struct LiveCounter {
+    static inline long live = 0;
+    static inline long peak = 0;
+    int value;
+
+    static void born() { if (++live > peak) peak = live; }
+
+    explicit LiveCounter(int v) : value(v) { born(); }   // žiadny implicitný konštruktor
+    LiveCounter(const LiveCounter& other) : value(other.value) { born(); }
+    LiveCounter(LiveCounter&& other) noexcept : value(other.value) { born(); }
+    LiveCounter& operator=(const LiveCounter&) = default;
+    LiveCounter& operator=(LiveCounter&&) noexcept = default;
+    ~LiveCounter() { --live; }
+};
+
+TEST(DataBlockTest, StorageIsUninitialized) {
+    LiveCounter::live = 0;
+    {
+        ResizableArray<LiveCounter, 3>::DataBlock block(1000);
+        EXPECT_EQ(block.size, 0u) << "A fresh block holds no live elements";
+        EXPECT_EQ(LiveCounter::live, 0) << "Allocating a block must not construct elements";
+    }
+    EXPECT_EQ(LiveCounter::live, 0);
+}
+
+TEST(DataBlockTest, OnlyLiveElementsAreConstructed) {
+    LiveCounter::live = 0;
+    {
+        ResizableArray<LiveCounter, 3> arr;
+        for (int i = 0; i < 3000; ++i) {
+            arr.emplace_back(i);
+            ASSERT_EQ(LiveCounter::live, i + 1) << "Exactly one object per element, i=" << i;
+        }
+        for (int i = 0; i < 2500; ++i) {
+            arr.shrink();
+            ASSERT_EQ(LiveCounter::live, static_cast<long>(arr.length()))
+                << "shrink() must destroy the removed element immediately";
+        }
+        for (size_t i = 0; i < arr.length(); ++i)
+            ASSERT_EQ(arr.get(i).value, static_cast<int>(i));
+    }
+    EXPECT_EQ(LiveCounter::live, 0) << "Destructor must destroy every live element";
+}
+
 // === TEST 2: DynamicArray push_back, erase, clear ===
 TEST(DynamicArrayTest, PushEraseClear) {
     TestArray::DynamicArray<TestArray::DataBlock> arr;
@@ -46,6 +108,47 @@ TEST(DynamicArrayTest, PushEraseClear) {
     EXPECT_EQ(arr.size, 0);
 }
 
+TEST(DynamicArrayTest, ItemTableFollowsBlocks) {
+    TestArray::DynamicArray<TestArray::DataBlock> arr;
+    for (int i = 0; i < 9; ++i)
+        arr.push_back(new TestArray::DataBlock(4)); // aj cez realokáciu tabuliek
+
+    TestArray::DataBlock* third = arr[2];
+    delete arr[0];
+    delete arr[1];
+    arr.detach_front(2);
+    ASSERT_EQ(arr.size, 7u);
+    EXPECT_EQ(arr[0], third);
+
+    TestArray::DataBlock* last = arr.take_back();
+    delete last;
+    for (size_t j = 0; j < arr.size; ++j) {
+        EXPECT_EQ(arr.items[j], arr[j]->data) << "items out of sync at " << j;
+    }
+}
+
+TEST(DynamicArrayTest, LevelTablesLiveInsideTheArray) {
+    // hlavička poľa začína na hranici cache line a úrovne nie sú na halde
+    static_assert(alignof(TestArray) >= 64);
+    static_assert(offsetof(TestArray, N_) == 0);
+
+    TestArray arr;
+    for (int i = 0; i < 3000; ++i) arr.push_back(i);
+    for (int i = 0; i < 1700; ++i) arr.shrink();
+    for (size_t lvl = 1; lvl < 3; ++lvl) {
+        for (size_t j = 0; j < arr.levels_[lvl].size; ++j) {
+            ASSERT_EQ(arr.levels_[lvl].items[j], arr.levels_[lvl][j]->data);
+        }
+    }
+
+    // moved-from pole je prázdne, ale použiteľné
+    TestArray moved(std::move(arr));
+    EXPECT_EQ(arr.length(), 0u);
+    arr.push_back(7);
+    EXPECT_EQ(arr.get(0), 7);
+    EXPECT_EQ(moved.get(1299), 1299);
+}
+
 // =======================================================================
 // =====================  TEST 3: Private Methods  =======================
 // =======================================================================
@@ -210,6 +313,35 @@ TEST(PrivateMethodsTest, LocateItemReturnsCorrectLevelAndOffset) {
     EXPECT_LE(p0.first, 2u);
 }
 
+// Rozvinuté levelOf() a predpočítané prahy musia sedieť pre každé R
+template<size_t Rr>
+void checkUnrolledLevelSearch() {
+    ResizableArray<int, Rr> arr;
+    for (int i = 0; i < 5000; ++i) {
+        arr.push_back(i);
+        ASSERT_EQ(arr.layout_.growAt, arr.power(arr.getParameterB(), Rr));
+    }
+    for (size_t idx = 0; idx < arr.length(); ++idx) {
+        size_t lvl = 1; // pôvodné lineárne hľadanie
+        while (lvl < Rr - 1 && idx < arr.layout_.start[lvl]) ++lvl;
+        ASSERT_EQ(arr.levelOf(idx), lvl) << "R=" << Rr << " index " << idx;
+        ASSERT_EQ(arr.get(idx), static_cast<int>(idx));
+    }
+    while (arr.length() > 1) {
+        arr.shrink();
+        const size_t b = arr.getParameterB();
+        ASSERT_EQ(arr.layout_.shrinkAt,
+                  b >= 8 ? arr.power(b / 4, Rr) : std::numeric_limits<size_t>::max());
+    }
+    EXPECT_EQ(arr.get(0), 0);
+}
+
+TEST(PrivateMethodsTest, UnrolledLevelSearchMatchesLoopForR2R3R4) {
+    checkUnrolledLevelSearch<2>();
+    checkUnrolledLevelSearch<3>();
+    checkUnrolledLevelSearch<4>();
+}
+
 // =======================================================================
 //  combineBlocks()
 // =======================================================================
@@ -344,6 +476,442 @@ TEST(PrivateMethodsTest, RebuildChangesBlockSizeAndKeepsData) {
 }
 
 
+// POD payload - ide cez memcpy cestu v combine/split/rebuild
+struct Point3 {
+    int x, y, z;
+};
+
+TEST(PrivateMethodsTest, RebuildOfTrivialTypeIsBlockwiseAndKeepsInvariants) {
+    ResizableArray<Point3, 3> arr;
+    std::vector<int> expected;
+
+    for (int i = 0; i < 2000; ++i) {
+        arr.push_back(Point3{i, -i, 2 * i});
+        expected.push_back(i);
+    }
+
+    for (size_t newB : {size_t{4}, size_t{32}, size_t{16}}) {
+        arr.rebuild(newB);
+        ASSERT_GE(arr.getParameterB(), newB);
+
+        // Counters must describe exactly the stored elements and stay within 2B.
+        size_t total = 0;
+        for (size_t lvl = 1; lvl < 3; ++lvl) {
+            EXPECT_LE(arr.n_[lvl], 2 * arr.getParameterB()) << "Level counter must stay <= 2B";
+            EXPECT_EQ(arr.levels_[lvl].size, arr.n_[lvl]);
+            total += arr.n_[lvl] * arr.power(arr.getParameterB(), lvl);
+        }
+        if (arr.n_[1] > 0) total -= arr.getParameterB() - arr.n0_;
+        EXPECT_EQ(total, arr.length()) << "Blocks must hold exactly N elements after rebuild";
+
+        for (size_t i = 0; i < arr.length(); ++i)
+            ASSERT_EQ(arr.get(i).y, -expected[i]);
+    }
+
+    // B that is too small for N is bumped so that N <= B^R still holds.
+    arr.rebuild(2);
+    EXPECT_GE(arr.power(arr.getParameterB(), 3), arr.length());
+
+    // The rebuilt structure must keep working for push/shrink in both directions.
+    for (int i = 0; i < 1500; ++i) { arr.shrink(); expected.pop_back(); }
+    for (int i = 0; i < 700; ++i) { arr.push_back(Point3{i, -i, 0}); expected.push_back(i); }
+    ASSERT_EQ(arr.length(), expected.size());
+    for (size_t i = 0; i < arr.length(); ++i)
+        ASSERT_EQ(arr.get(i).x, expected[i]);
+}
+
+TEST(PrivateMethodsTest, RebuildStreamsBlocksWithoutFullCopy) {
+    LiveCounter::live = 0;
+    ResizableArray<LiveCounter, 3> arr;
+    for (int i = 0; i < 4000; ++i) arr.emplace_back(i);
+    const long n = static_cast<long>(arr.length());
+
+    const size_t newB = arr.getParameterB() * 2;
+    const long maxBlock = static_cast<long>(arr.power(newB, 2)); // B'^(R-1)
+
+    LiveCounter::peak = LiveCounter::live;
+    arr.rebuild(newB);
+
+    // A buffered rebuild would hold 2N objects at its peak; streaming holds at
+    // most one extra block worth of relocated elements.
+    EXPECT_LE(LiveCounter::peak, n + maxBlock) << "Rebuild must not materialize a full copy";
+    EXPECT_EQ(LiveCounter::live, n) << "Every source element must be destroyed after relocation";
+    for (size_t i = 0; i < arr.length(); ++i)
+        ASSERT_EQ(arr.get(i).value, static_cast<int>(i));
+
+    // Same for shrinking B.
+    LiveCounter::peak = LiveCounter::live;
+    arr.rebuild(newB / 2);
+    EXPECT_LE(LiveCounter::peak, n + maxBlock);
+    for (size_t i = 0; i < arr.length(); ++i)
+        ASSERT_EQ(arr.get(i).value, static_cast<int>(i));
+}
+
+TEST(PrivateMethodsTest, RebuildRequiresPowerOfTwoB) {
+    TestArray arr;
+    for (int i = 0; i < 30; i++)
+        arr.push_back(i);
+
+    // B must stay a power of two so get() can index with shifts and masks.
+    EXPECT_THROW(arr.rebuild(6), std::invalid_argument) << "Non power-of-two B must be rejected";
+    EXPECT_THROW(arr.rebuild(1), std::invalid_argument) << "B < 2 must be rejected";
+    EXPECT_THROW(arr.rebuild(0), std::invalid_argument) << "B == 0 must be rejected";
+
+    // A rejected rebuild must leave the array untouched.
+    EXPECT_EQ(arr.length(), 30u);
+    for (int i = 0; i < 30; i++)
+        EXPECT_EQ(arr.get(i), i);
+
+    // Shifts/masks must follow the new B after a valid rebuild.
+    arr.rebuild(16);
+    EXPECT_EQ(arr.layout_.blockSize[1], 16u);
+    EXPECT_EQ(arr.layout_.shift[2], 8u) << "shift[i] must equal log2(B^i)";
+    for (int i = 0; i < 30; i++)
+        EXPECT_EQ(arr.get(i), i);
+}
+
+
+// =======================================================================
+//  Postupný (deamortizovaný) rebuild
+// =======================================================================
+//
+// Na prahu rebuildu ostane stará geometria žiť vedľa novej a každá operácia
+// presunie len O(B) prvkov. get(), iterátory aj segmenty musia vidieť obe časti.
+//
+
+TEST(IncrementalRebuildTest, GrowThresholdMigratesBoundedChunkPerOperation) {
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+    EXPECT_TRUE(arr.incrementalRebuild());
+
+    const size_t B = arr.getParameterB();
+    const size_t threshold = arr.power(B, 3);
+    for (size_t i = 0; i < threshold; ++i) arr.push_back(static_cast<int>(i));
+    EXPECT_FALSE(arr.rebuildInProgress());
+
+    arr.push_back(static_cast<int>(threshold));
+    ASSERT_TRUE(arr.rebuildInProgress()) << "Crossing B^r must start a migration, not a full rebuild";
+    EXPECT_EQ(arr.getParameterB(), 2 * B) << "New elements already use the new geometry";
+
+    // Each further push moves at most B' = 2B elements, not a whole B^(r-1) block
+    // of the old geometry.
+    const size_t maxMoved = 2 * B;
+    size_t next = threshold + 1;
+    while (arr.rebuildInProgress()) {
+        const size_t before = arr.length() - arr.N_;
+        arr.push_back(static_cast<int>(next++));
+        const size_t after = arr.rebuildInProgress() ? arr.length() - arr.N_ : 0;
+        ASSERT_LE(before + 1 - after, maxMoved + 1) << "One operation must migrate at most O(B) elements";
+
+        // Both geometries must be visible through every access path.
+        ASSERT_EQ(arr.length(), next);
+        ASSERT_EQ(arr.get(0), 0);
+        ASSERT_EQ(arr.get(next - 1), static_cast<int>(next - 1));
+    }
+    EXPECT_LE(next - threshold, threshold / maxMoved + 2) << "Migration must finish after O(N / B) operations";
+    EXPECT_LT(next, arr.power(2 * B, 3)) << "Migration must finish before the next threshold";
+
+    for (size_t i = 0; i < arr.length(); ++i)
+        ASSERT_EQ(arr.get(i), static_cast<int>(i));
+}
+
+TEST(IncrementalRebuildTest, MixedTraceMatchesVectorDuringMigration) {
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+    std::vector<int> vec;
+
+    // Deterministic push/shrink trace that crosses grow and shrink thresholds repeatedly.
+    unsigned state = 12345u;
+    auto rnd = [&]() { state = state * 1103515245u + 12345u; return (state >> 16) & 0x7fff; };
+    size_t migrationsSeen = 0;
+
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 6000; ++i) {
+            if (rnd() % 10 < 7 || vec.empty()) { int v = static_cast<int>(rnd()); arr.push_back(v); vec.push_back(v); }
+            else { arr.shrink(); vec.pop_back(); }
+            if (arr.rebuildInProgress()) {
+                ++migrationsSeen;
+                ASSERT_EQ(arr.length(), vec.size());
+                ASSERT_EQ(arr.get(arr.length() - 1), vec.back());
+            }
+        }
+        while (vec.size() > 20) {
+            arr.shrink();
+            vec.pop_back();
+            if (arr.rebuildInProgress()) {
+                ++migrationsSeen;
+                // Iterators and segments must see old + new parts in order.
+                ASSERT_TRUE(std::equal(arr.begin(), arr.end(), vec.begin(), vec.end()));
+                size_t seen = 0;
+                for (std::span<int> segment : arr.segments()) {
+                    for (int x : segment) ASSERT_EQ(x, vec[seen++]);
+                }
+                ASSERT_EQ(seen, vec.size());
+            }
+        }
+    }
+    EXPECT_GT(migrationsSeen, 0u) << "The trace must actually exercise migrations";
+
+    ASSERT_EQ(arr.length(), vec.size());
+    for (size_t i = 0; i < vec.size(); ++i) ASSERT_EQ(arr.get(i), vec[i]);
+}
+
+TEST(IncrementalRebuildTest, IteratorsMatchAtEveryMigrationStep) {
+    // Počas migrácie je posledný B-blok novej geometrie čiastočný a za ním
+    // pokračuje rozpracovaný blok a stará geometria - iterátor nesmie čítať za n0_.
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+    std::vector<int> vec;
+    auto expectSame = [&] {
+        ASSERT_EQ(arr.length(), vec.size());
+        ASSERT_TRUE(std::equal(arr.begin(), arr.end(), vec.begin(), vec.end()));
+        size_t back = vec.size();
+        arr.scan(-1, [&](int x) { ASSERT_EQ(x, vec[--back]); });
+        ASSERT_EQ(back, 0u);
+        size_t seen = 0;
+        for (std::span<int> segment : arr.segments()) {
+            for (int x : segment) ASSERT_EQ(x, vec[seen++]);
+        }
+        ASSERT_EQ(seen, vec.size());
+        // iterátor začatý uprostred (seek) a prejdený cez hranice častí
+        for (size_t from : {arr.N_ - arr.N_ / 3, arr.N_ - 1, arr.N_, arr.N_ + 1}) {
+            if (from >= vec.size()) continue;
+            ASSERT_TRUE(std::equal(arr.begin() + from, arr.end(), vec.begin() + from, vec.end()));
+        }
+    };
+
+    // dva prahy rastu (B = 4 -> 8 -> 16), potom zmenšovanie až na prázdne pole
+    size_t steps = 0;
+    for (int i = 0; i < 1200; ++i) {
+        arr.push_back(i);
+        vec.push_back(i);
+        if (arr.rebuildInProgress()) {
+            ++steps;
+            expectSame();
+        }
+    }
+    ASSERT_EQ(arr.getParameterB(), 16u);
+    ASSERT_GT(steps, 2u) << "The grow migrations must span several operations";
+
+    steps = 0;
+    while (!vec.empty()) {
+        arr.shrink();
+        vec.pop_back();
+        if (arr.rebuildInProgress()) {
+            ++steps;
+            expectSame();
+        }
+    }
+    ASSERT_GT(steps, 2u) << "The shrink migrations must span several operations";
+    expectSame();
+}
+
+TEST(IncrementalRebuildTest, CopyMoveAndDisableDuringMigration) {
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+    const size_t threshold = arr.power(arr.getParameterB(), 3);
+    for (size_t i = 0; i <= threshold; ++i) arr.push_back(static_cast<int>(i));
+    ASSERT_TRUE(arr.rebuildInProgress());
+
+    TestArray copy(arr);
+    ASSERT_EQ(copy.length(), arr.length());
+    for (size_t i = 0; i < copy.length(); ++i) ASSERT_EQ(copy.get(i), static_cast<int>(i));
+
+    TestArray moved(std::move(arr));
+    EXPECT_TRUE(moved.rebuildInProgress()) << "Move must carry the old geometry along";
+    EXPECT_TRUE(arr.empty());
+    ASSERT_EQ(moved.length(), threshold + 1);
+
+    // Turning the mode off completes the migration synchronously.
+    moved.setIncrementalRebuild(false);
+    EXPECT_FALSE(moved.rebuildInProgress());
+    for (size_t i = 0; i < moved.length(); ++i) ASSERT_EQ(moved.get(i), static_cast<int>(i));
+
+    // A full rebuild in the middle of a migration finishes it first.
+    TestArray other;
+    other.setIncrementalRebuild(true);
+    for (size_t i = 0; i <= threshold; ++i) other.push_back(static_cast<int>(i));
+    ASSERT_TRUE(other.rebuildInProgress());
+    other.rebuild(other.getParameterB());
+    EXPECT_FALSE(other.rebuildInProgress());
+    for (size_t i = 0; i < other.length(); ++i) ASSERT_EQ(other.get(i), static_cast<int>(i));
+}
+
+// =======================================================================
+//  Zdroj pamäte a pool blokov
+// =======================================================================
+
+// Počíta alokácie a deleguje na predvolený zdroj
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocations = 0;
+    size_t live = 0;
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        ++allocations;
+        live += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+TEST(BlockPoolTest, AllocatesFromGivenResource) {
+    CountingResource mr;
+    {
+        TestArray arr(&mr);
+        EXPECT_EQ(arr.resource(), &mr);
+        for (int i = 0; i < 5000; ++i) arr.push_back(i);
+        EXPECT_GT(mr.allocations, 0u);
+        EXPECT_GE(mr.live, 5000 * sizeof(int)); // bloky aj polia blokov
+
+        TestArray moved(std::move(arr));
+        while (moved.length() > 10) moved.shrink();
+        for (size_t i = 0; i < moved.length(); ++i) ASSERT_EQ(moved.get(i), static_cast<int>(i));
+    }
+    EXPECT_EQ(mr.live, 0u);
+}
+
+TEST(BlockPoolTest, PushShrinkAtBlockEdgeDoesNotAllocate) {
+    CountingResource mr;
+    TestArray arr(&mr);
+    arr.setBlockPool(true);
+    for (int i = 0; i < 4 * 16; ++i) arr.push_back(i); // presne na hranici B-bloku
+
+    // combineBlocks/splitBlocks aj posledný B-blok idú cez pool
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 40; ++i) arr.push_back(i);
+        for (int i = 0; i < 40; ++i) arr.shrink();
+    }
+    const size_t before = mr.allocations;
+    for (int round = 0; round < 100; ++round) {
+        arr.push_back(round);
+        arr.shrink();
+    }
+    EXPECT_EQ(mr.allocations, before);
+    ASSERT_EQ(arr.length(), 64u);
+    for (size_t i = 0; i < arr.length(); ++i) ASSERT_EQ(arr.get(i), static_cast<int>(i));
+
+    arr.setBlockPool(false); // odložené bloky sa uvoľnia
+    const size_t liveBefore = mr.live;
+    arr.push_back(1);
+    arr.shrink();
+    EXPECT_GT(mr.allocations, before);
+    EXPECT_EQ(mr.live, liveBefore);
+}
+
+
+TEST(BlockPoolTest, SpareTailStopsAllocFreeThrashing) {
+    CountingResource mr;
+    // Posledný B-blok má práve jeden prvok: každý shrink ho vyprázdni a uvoľní,
+    // každý push_back potrebuje nový. Vráti počet alokácií počas 1000 takých kôl.
+    auto thrash = [&](TestArray& a) {
+        for (int i = 0; i < 90 || a.n0_ != 1; ++i) a.push_back(i);
+        const size_t before = mr.allocations;
+        for (int round = 0; round < 1000; ++round) {
+            a.shrink();          // vyprázdni posledný B-blok
+            a.push_back(round);  // znova ho potrebuje
+        }
+        return mr.allocations - before;
+    };
+
+    TestArray control(&mr);
+    EXPECT_GE(thrash(control), 1000u) << "Without the spare tail every round allocates a B-block";
+
+    TestArray arr(&mr);
+    arr.setRetainSpareTail(true);
+    EXPECT_EQ(thrash(arr), 0u) << "The emptied B-block must be kept and reused";
+
+    // navyše je najviac jeden B-blok, aj keď sa zmenšuje cez viac blokov
+    TestArray plain(&mr);
+    for (int i = 0; i < 100; ++i) plain.push_back(i);
+    const size_t withPlain = mr.live;
+    for (int i = 0; i < 30; ++i) {
+        arr.shrink();
+        plain.shrink();
+    }
+    EXPECT_LE(mr.live, withPlain + arr.getParameterB() * sizeof(int));
+
+    // ďalej sa správa ako bežné pole (aj splitBlocks a rebuild)
+    while (arr.length() > 1) arr.shrink();
+    for (int i = 0; i < 300; ++i) arr.push_back(i);
+    ASSERT_EQ(arr.length(), 301u);
+    for (size_t i = 1; i < arr.length(); ++i) ASSERT_EQ(arr.get(i), static_cast<int>(i - 1));
+
+    arr.setRetainSpareTail(false);
+    EXPECT_FALSE(arr.retainSpareTail());
+}
+
+TEST(StatsTest, AccountsForEveryAllocatedByte) {
+    CountingResource mr;
+    TestArray arr(&mr);
+    for (int i = 0; i < 100000; ++i) arr.push_back(i);
+    for (int i = 0; i < 777; ++i) arr.shrink();
+
+    const auto s = arr.stats();
+    EXPECT_EQ(s.length, arr.length());
+    EXPECT_EQ(s.B, arr.getParameterB());
+    EXPECT_EQ(s.elementBytes, arr.length() * sizeof(int));
+
+    size_t blocks = 0, slack = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(s.blocks[i], arr.n_[i]);
+        blocks += s.blocks[i];
+        slack  += s.slackBytes[i];
+    }
+    EXPECT_EQ(s.slackBytes[2], 0u) << "Only the level-1 tail block may be partial";
+    EXPECT_EQ(s.blockBytes, s.elementBytes + slack);
+
+    // cez zdroj idú bloky aj tabuľky blokov, hlavičky DataBlock nie
+    EXPECT_EQ(mr.live, s.totalBytes - blocks * sizeof(TestArray::DataBlock));
+
+    // N + O(N^(1/r)): pri N = 10^5 a r = 3 je réžia malá
+    EXPECT_LT(s.overheadBytes(), s.elementBytes / 8);
+    EXPECT_EQ(s.spareBytes, 0u);
+    EXPECT_EQ(s.migratingBytes, 0u);
+}
+
+TEST(StatsTest, TracksRebuildPeakAndMigration) {
+    TestArray arr;
+    EXPECT_EQ(arr.stats().peakRebuildBytes, 0u);
+    for (int i = 0; i < 5000; ++i) arr.push_back(i);
+
+    // posledný rebuild prebehol pri N = 16^3 (B 16 -> 32): staré aj nové bloky naraz
+    const auto s = arr.stats();
+    EXPECT_GE(s.peakRebuildBytes, 4096 * sizeof(int));
+    EXPECT_LT(s.peakRebuildBytes, 3 * 4096 * sizeof(int));
+    arr.resetStats();
+    EXPECT_EQ(arr.stats().peakRebuildBytes, 0u);
+
+    TestArray inc;
+    inc.setIncrementalRebuild(true);
+    int k = 0;
+    while (!inc.rebuildInProgress()) inc.push_back(k++);
+    const auto m = inc.stats();
+    EXPECT_GT(m.migratingBytes, 0u);
+    EXPECT_EQ(m.length, inc.length());
+    EXPECT_EQ(m.totalBytes, m.blockBytes + m.tableBytes[0] + m.tableBytes[1] + m.tableBytes[2] + m.migratingBytes);
+
+#if RARRAY_INSTRUMENT
+    const auto st = arr.stats();
+    EXPECT_EQ(st.rebuild.calls, 0u);
+    for (int i = 0; i < 300000; ++i) arr.push_back(i);
+    const auto grown = arr.stats();
+    EXPECT_GT(grown.combine.calls, 0u);
+    EXPECT_GT(grown.rebuild.calls, 0u);
+    size_t hist = 0;
+    for (size_t c : grown.combine.latencyLog2) hist += c;
+    EXPECT_EQ(hist, grown.combine.calls);
+    EXPECT_GE(grown.combine.totalNs, grown.combine.maxNs);
+    while (!arr.empty()) arr.shrink();
+    EXPECT_GT(arr.stats().split.calls, 0u);
+#endif
+}
+
 // =======================================================================
 // =====================  TEST 4: Public Methods  ========================
 // =======================================================================
@@ -401,6 +969,73 @@ TEST(PublicMethodsTest, push_backAddsElementsCorrectly) {
     EXPECT_EQ(arr.get(205), 1199) << "Last element must match the last appended value";
 }
 
+// =======================================================================
+//  push_back(T&&) / emplace_back() — presun namiesto kópie
+// =======================================================================
+
+// Počíta kópie, aby sa dalo overiť, že vnútorné presuny blokov nekopírujú
+struct CopyCounter {
+    static inline size_t copies = 0;
+    int value = 0;
+
+    CopyCounter() = default;
+    explicit CopyCounter(int v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value) {}
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&& other) noexcept { value = other.value; return *this; }
+};
+
+TEST(PublicMethodsTest, MovePushBackNeverCopiesInternally) {
+    ResizableArray<CopyCounter, 3> arr;
+    CopyCounter::copies = 0;
+
+    // Enough elements to go through several combines, splits and rebuilds.
+    for (int i = 0; i < 5000; ++i) arr.push_back(CopyCounter(i));
+    for (int i = 0; i < 4000; ++i) arr.shrink();
+    for (int i = 0; i < 100; ++i) arr.emplace_back(i);
+
+    EXPECT_EQ(CopyCounter::copies, 0u) << "combine/split/rebuild must move, not copy";
+    ASSERT_EQ(arr.length(), 1100u);
+    for (size_t i = 0; i < 1000; ++i) ASSERT_EQ(arr.get(i).value, static_cast<int>(i));
+    EXPECT_EQ(arr.get(1000).value, 0);
+
+    // Copying the whole array is the only place where copies are expected.
+    ResizableArray<CopyCounter, 3> copy(arr);
+    EXPECT_EQ(CopyCounter::copies, arr.length());
+}
+
+TEST(PublicMethodsTest, EmplaceBackConstructsInPlace) {
+    ResizableArray<std::string, 3> arr;
+
+    std::string& ref = arr.emplace_back(3, 'x');
+    EXPECT_EQ(ref, "xxx") << "emplace_back must forward constructor arguments";
+
+    std::string moved = "payload";
+    arr.push_back(std::move(moved));
+    EXPECT_EQ(arr.get(1), "payload");
+
+    arr.set(0, std::string("set"));
+    EXPECT_EQ(arr.get(0), "set");
+}
+
+TEST(PublicMethodsTest, PushBackOfOwnElementSurvivesRestructuring) {
+    TestArray arr;
+
+    // Every push re-inserts an existing element, including at the combine and
+    // rebuild boundaries where the referenced block is relocated.
+    arr.push_back(7);
+    for (int i = 0; i < 3000; ++i) {
+        arr.push_back(arr.get(0));
+        ASSERT_EQ(arr.get(arr.length() - 1), 7) << "Reference argument must not dangle, i=" << i;
+    }
+
+    ResizableArray<std::string, 3> words;
+    words.push_back("head");
+    for (int i = 0; i < 500; ++i) words.emplace_back(words.get(0));
+    EXPECT_EQ(words.get(500), "head");
+}
+
 // =======================================================================
 //  shrink() — odstráni posledný prvok
 // =======================================================================
@@ -472,6 +1107,93 @@ TEST(PublicMethodsTest, GetThrowsOnInvalidIndex) {
     EXPECT_THROW(arr.get(static_cast<size_t>(-1)), std::out_of_range) << "get(very large) must throw";
 }
 
+// =======================================================================
+//  get_unchecked() — get() bez kontroly hraníc, cez predpočítaný layout
+// =======================================================================
+
+TEST(PublicMethodsTest, GetUncheckedMatchesVectorAcrossRestructuring) {
+    // get() volá get_unchecked(), preto porovnávame s nezávislou referenciou
+    TestArray arr;
+    std::vector<int> ref;
+    std::mt19937 rng(97);
+    auto expectSame = [&](const char* phase) {
+        ASSERT_EQ(arr.length(), ref.size());
+        for (size_t j = 0; j < ref.size(); ++j)
+            ASSERT_EQ(arr.get_unchecked(j), ref[j]) << phase << ", index " << j;
+    };
+
+    // Grow through several combines and rebuilds, then shrink through splits.
+    for (int i = 0; i < 3000; ++i) {
+        const int v = static_cast<int>(rng());
+        arr.push_back(v);
+        ref.push_back(v);
+        if (i % 97 == 0) expectSame("layout cache after growth");
+    }
+    expectSame("after growth");
+
+    while (arr.length() > 10) {
+        arr.shrink();
+        ref.pop_back();
+        ASSERT_EQ(arr.get_unchecked(ref.size() - 1), ref.back())
+            << "Cached level boundaries must follow split/rebuild";
+        if (ref.size() % 89 == 0) expectSame("layout cache after shrinking");
+    }
+
+    const TestArray& constArr = arr;
+    EXPECT_EQ(constArr.get_unchecked(0), ref[0]);
+    EXPECT_EQ(constArr.get_unchecked(9), ref[9]);
+}
+
+// =======================================================================
+//  get_many() — hromadné čítanie náhodných indexov
+// =======================================================================
+
+template<size_t Rr>
+void checkGetMany(size_t count) {
+    ResizableArray<int, Rr> arr;
+    for (size_t i = 0; i < count; ++i) arr.push_back(static_cast<int>(i * 7));
+
+    std::mt19937_64 rng(42 + Rr);
+    std::vector<size_t> idx(1000 + 3); // aj neúplná posledná dávka
+    for (auto& x : idx) x = rng() % count;
+    idx[0] = 0;
+    idx[1] = count - 1;
+
+    std::vector<int> out(idx.size(), -1);
+    arr.get_many(idx.data(), idx.size(), out.data());
+    for (size_t k = 0; k < idx.size(); ++k) {
+        ASSERT_EQ(out[k], arr.get(idx[k])) << "R=" << Rr << " index " << idx[k];
+    }
+}
+
+TEST(PublicMethodsTest, GetManyMatchesGet) {
+    checkGetMany<2>(3000);
+    checkGetMany<3>(20000);
+    checkGetMany<4>(20000);
+
+    TestArray arr;
+    for (int i = 0; i < 10; ++i) arr.push_back(i);
+    size_t bad[] = {1, 10};
+    int out[2];
+    EXPECT_THROW(arr.get_many(bad, 2, out), std::out_of_range);
+    arr.get_many(bad, 0, out); // prázdna dávka nič nerobí
+}
+
+TEST(PublicMethodsTest, GetManyDuringIncrementalRebuild) {
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+    for (int i = 0; i < 70; ++i) arr.push_back(i);
+    ASSERT_TRUE(arr.rebuildInProgress());
+
+    std::vector<size_t> idx(arr.length());
+    for (size_t i = 0; i < idx.size(); ++i) idx[i] = idx.size() - 1 - i;
+    std::vector<int> out(idx.size());
+    arr.get_many(idx.data(), idx.size(), out.data());
+    for (size_t k = 0; k < idx.size(); ++k) {
+        ASSERT_EQ(out[k], static_cast<int>(idx[k]));
+    }
+}
+
 // =======================================================================
 //  set() — nastaví novú hodnotu na indexe
 // =======================================================================
@@ -654,6 +1376,51 @@ TEST(PublicMethodsTest, CopyAssignmentCreatesIndependentCopy) {
     EXPECT_EQ(copy.get(0), firstBefore) << "Self-assignment must preserve content";
 }
 
+TEST(PublicMethodsTest, CopyClonesBlockGeometry) {
+    TestArray arr;
+    for (int i = 0; i < 9000; ++i) arr.push_back(i);
+    for (int i = 0; i < 2500; ++i) arr.shrink(); // tvar, ktorý push_back sám nevyrobí
+
+    CountingResource mr;
+    TestArray copy(&mr);
+    copy = arr;
+
+    ASSERT_EQ(copy.length(), arr.length());
+    EXPECT_EQ(copy.B_, arr.B_);
+    EXPECT_EQ(copy.n0_, arr.n0_);
+    size_t blocks = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(copy.n_[i], arr.n_[i]) << "Copy must keep block count at level " << i;
+        blocks += arr.n_[i];
+    }
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), arr.begin()));
+    EXPECT_EQ(copy.resource(), &mr) << "Copy assignment keeps the target resource";
+    // jedna alokácia na blok + tabuľky blokov úrovní
+    EXPECT_LE(mr.allocations, blocks + 2 * 2);
+
+    // kópia je samostatné pole a rastie/zmenšuje sa normálne
+    TestArray ctor(copy);
+    for (int i = 0; i < 5000; ++i) ctor.push_back(-i);
+    while (ctor.length() > 10) ctor.shrink();
+    EXPECT_EQ(ctor.get(9), 9);
+    EXPECT_EQ(copy.length(), 6500u);
+
+    ResizableArray<std::string, 3> words;
+    for (int i = 0; i < 300; ++i) words.push_back(std::to_string(i));
+    ResizableArray<std::string, 3> wordsCopy(words);
+    EXPECT_TRUE(std::equal(wordsCopy.begin(), wordsCopy.end(), words.begin()));
+
+    // počas postupného rebuildu dostane kópia kanonický tvar
+    TestArray inc;
+    inc.setIncrementalRebuild(true);
+    int k = 0;
+    while (!inc.rebuildInProgress()) inc.push_back(k++);
+    TestArray incCopy(inc);
+    EXPECT_FALSE(incCopy.rebuildInProgress());
+    ASSERT_EQ(incCopy.length(), inc.length());
+    EXPECT_TRUE(std::equal(incCopy.begin(), incCopy.end(), inc.begin()));
+}
+
 
 // =======================================================================
 //  Move constructor — presunie vnútorné dáta
@@ -759,6 +1526,146 @@ TEST(PublicMethodsTest, PushBackAllAppendsToExistingData) {
     EXPECT_EQ(arr.get(3), 3);
 }
 
+// =======================================================================
+//  append()
+// =======================================================================
+
+TEST(PublicMethodsTest, AppendJumpsToFinalGeometry) {
+    std::vector<int> v(20000);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(i * 3);
+
+    TestArray arr;
+    arr.push_back(-1);
+    arr.append(std::span<const int>(v));
+
+    // rovnaké B, aké by vzniklo postupnými push_back
+    TestArray ref;
+    ref.push_back(-1);
+    for (int x : v) ref.push_back(x);
+    EXPECT_EQ(arr.getParameterB(), ref.getParameterB());
+
+    ASSERT_EQ(arr.length(), v.size() + 1);
+    EXPECT_EQ(arr.get(0), -1);
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(arr.get(i + 1), v[i]) << "mismatch at " << i;
+    }
+
+    // štruktúra ostala platná pre ďalšie operácie
+    while (!arr.empty()) arr.shrink();
+    EXPECT_EQ(arr.getParameterB(), TestArray::INITIAL_B);
+}
+
+TEST(PublicMethodsTest, AppendSmallBatchesMatchesVector) {
+    TestArray arr;
+    std::vector<int> ref;
+    int next = 0;
+    for (size_t batch = 1; batch < 90; ++batch) {
+        std::vector<int> chunk;
+        for (size_t i = 0; i < batch; ++i) chunk.push_back(next++);
+        arr.append(chunk.begin(), chunk.end());
+        ref.insert(ref.end(), chunk.begin(), chunk.end());
+        if (batch % 7 == 0) {
+            arr.shrink();
+            ref.pop_back();
+        }
+    }
+
+    ASSERT_EQ(arr.length(), ref.size());
+    EXPECT_TRUE(std::equal(arr.begin(), arr.end(), ref.begin()));
+    while (!arr.empty()) arr.shrink();
+}
+
+TEST(PublicMethodsTest, AppendFromResizableArrayAndSinglePassInput) {
+    TestArray src;
+    for (int i = 0; i < 500; ++i) src.push_back(i);
+
+    TestArray dst;
+    dst.push_back_all(src);
+    dst.push_back_all(dst); // sám so sebou
+
+    ASSERT_EQ(dst.length(), 1000u);
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(dst.get(i), static_cast<int>(i % 500));
+    }
+
+    std::istringstream in("7 8 9");
+    TestArray fromStream;
+    fromStream.append(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    ASSERT_EQ(fromStream.length(), 3u);
+    EXPECT_EQ(fromStream.get(2), 9);
+}
+
+TEST(PublicMethodsTest, AppendDuringIncrementalRebuild) {
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+
+    std::vector<int> ref;
+    for (int i = 0; i < 64; ++i) {
+        arr.push_back(i);
+        ref.push_back(i);
+    }
+    std::vector<int> chunk = {100, 101, 102};
+    arr.append(std::span<const int>(chunk)); // spustí postupný rebuild
+    ref.insert(ref.end(), chunk.begin(), chunk.end());
+    EXPECT_TRUE(arr.rebuildInProgress());
+
+    ASSERT_EQ(arr.length(), ref.size());
+    EXPECT_TRUE(std::equal(arr.begin(), arr.end(), ref.begin()));
+}
+
+// =======================================================================
+//  reserve() / shrink_to_fit()
+// =======================================================================
+
+TEST(PublicMethodsTest, ReservePicksFinalBUpFront) {
+    TestArray arr;
+    arr.push_back(1);
+    arr.reserve(100000);
+
+    const size_t b = arr.getParameterB();
+    EXPECT_GE(arr.power(b, 3), 100000u);
+    EXPECT_LT(arr.power(b / 2, 3), 100000u);
+
+    // už žiadny rebuild ani realokácia polí blokov
+    auto* topBlocks = arr.levels_[2].data;
+    for (int i = 2; i <= 100000; ++i) {
+        arr.push_back(i);
+        ASSERT_EQ(arr.getParameterB(), b) << "rebuild at " << i;
+    }
+    EXPECT_EQ(arr.levels_[2].data, topBlocks);
+
+    for (size_t i = 0; i < arr.length(); ++i) {
+        ASSERT_EQ(arr.get(i), static_cast<int>(i + 1));
+    }
+
+    arr.reserve(10); // menšie n nič nerobí
+    EXPECT_EQ(arr.getParameterB(), b);
+}
+
+TEST(PublicMethodsTest, ShrinkToFitRestoresMinimalGeometry) {
+    TestArray arr;
+    arr.reserve(1 << 20);
+    for (int i = 0; i < 100; ++i) arr.push_back(i);
+
+    arr.shrink_to_fit();
+    EXPECT_EQ(arr.getParameterB(), 8u); // 4^3 < 100 <= 8^3
+    for (size_t i = 1; i < 3; ++i) {
+        EXPECT_EQ(arr.levels_[i].capacity, arr.levels_[i].size);
+    }
+    for (size_t i = 0; i < arr.length(); ++i) {
+        ASSERT_EQ(arr.get(i), static_cast<int>(i));
+    }
+
+    // po zmenšení kapacity musia ďalšie operácie fungovať normálne
+    for (int i = 100; i < 1000; ++i) arr.push_back(i);
+    for (size_t i = 0; i < arr.length(); ++i) {
+        ASSERT_EQ(arr.get(i), static_cast<int>(i));
+    }
+    while (!arr.empty()) arr.shrink();
+    arr.shrink_to_fit();
+    EXPECT_EQ(arr.getParameterB(), TestArray::INITIAL_B);
+}
+
 // =======================================================================
 //  sub_rarray()
 // =======================================================================
@@ -816,6 +1723,65 @@ TEST(PublicMethodsTest, SubRarrayDoesNotAffectOriginal) {
     EXPECT_EQ(arr.get(1), 1) << "Original array must remain unchanged";
 }
 
+TEST(PublicMethodsTest, SubRarrayCopiesBlockRangesAcrossGeometries) {
+    TestArray arr;
+    for (int i = 0; i < 20000; ++i) arr.push_back(i);
+
+    // začiatky/konce v strede blokov, na hraniciach úrovní aj jednoprvkové
+    const std::pair<size_t, size_t> ranges[] = {
+        {0, 20000}, {1, 19999}, {4095, 4097}, {333, 333}, {19999, 20000}, {100, 15000}};
+    for (auto [from, to] : ranges) {
+        auto sub = arr.sub_rarray(from, to);
+        ASSERT_EQ(sub.length(), to - from);
+        for (size_t i = 0; i < sub.length(); ++i) {
+            ASSERT_EQ(sub.get(i), static_cast<int>(from + i)) << "range " << from << ".." << to << " at " << i;
+        }
+
+        // rovnaká geometria, ako keby sa prvky pridávali po jednom
+        TestArray ref;
+        for (size_t i = from; i < to; ++i) ref.push_back(static_cast<int>(i));
+        EXPECT_EQ(sub.getParameterB(), ref.getParameterB());
+        sub.push_back(-1);
+        while (!sub.empty()) sub.shrink();
+    }
+
+    ResizableArray<std::string, 3> words;
+    for (int i = 0; i < 200; ++i) words.push_back(std::to_string(i));
+    auto mid = words.sub_rarray(17, 150);
+    ASSERT_EQ(mid.length(), 133u);
+    EXPECT_EQ(mid.get(0), "17");
+    EXPECT_EQ(mid.get(132), "149");
+}
+
+TEST(PublicMethodsTest, ViewIndexesParentWithoutCopying) {
+    TestArray arr;
+    for (int i = 0; i < 3000; ++i) arr.push_back(i);
+
+    auto view = arr.view(250, 2750);
+    ASSERT_EQ(view.length(), 2500u);
+    EXPECT_EQ(&view[0], &arr.get(250)) << "View must alias parent storage";
+    EXPECT_EQ(view.get(2499), 2749);
+    EXPECT_THROW(view.get(2500), std::out_of_range);
+    EXPECT_THROW(arr.view(10, 3001), std::out_of_range);
+
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), arr.begin() + 250));
+
+    size_t seen = 0;
+    view.for_each_segment([&](std::span<const int> segment) {
+        for (int x : segment) ASSERT_EQ(x, static_cast<int>(250 + seen++));
+    });
+    EXPECT_EQ(seen, view.length());
+
+    auto inner = view.subview(10, 20);
+    EXPECT_EQ(inner.length(), 10u);
+    EXPECT_EQ(inner[0], 260);
+    EXPECT_TRUE(arr.view(5, 5).empty());
+
+    auto copy = inner.to_rarray();
+    ASSERT_EQ(copy.length(), 10u);
+    EXPECT_EQ(copy.get(9), 269);
+}
+
 // =======================================================================
 //  ITERATORS
 // =======================================================================
@@ -915,6 +1881,120 @@ TEST(IteratorTest, IteratorAfterModifications) {
     EXPECT_EQ(i, arr.length());
 }
 
+static_assert(std::random_access_iterator<TestArray::Iterator>);
+static_assert(std::random_access_iterator<TestArray::ConstIterator>);
+
+TEST(IteratorTest, RandomAccessArithmetic) {
+    TestArray arr;
+    for (int i = 0; i < 500; ++i) arr.push_back(i);
+
+    auto it = arr.begin();
+    EXPECT_EQ(*(it + 123), 123);
+    EXPECT_EQ(it[499], 499);
+    EXPECT_EQ(arr.end() - arr.begin(), 500);
+
+    // Jumps inside a block and across level boundaries must land on the right element.
+    it += 250;
+    EXPECT_EQ(*it, 250);
+    it -= 249;
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(*(arr.end() - 1), 499) << "Stepping back from end() must reach the last element";
+
+    EXPECT_TRUE(arr.begin() < arr.end());
+    EXPECT_TRUE(arr.begin() + 10 == arr.begin() + 10);
+
+    // Iterator converts to ConstIterator
+    TestArray::ConstIterator cit = arr.begin() + 5;
+    EXPECT_EQ(*cit, 5);
+}
+
+TEST(IteratorTest, ReverseIterationCrossesBlocks) {
+    TestArray arr;
+    for (int i = 0; i < 300; ++i) arr.push_back(i);
+
+    int expected = 299;
+    for (auto it = arr.end(); it != arr.begin();) {
+        --it;
+        EXPECT_EQ(*it, expected--);
+    }
+    EXPECT_EQ(expected, -1);
+}
+
+TEST(IteratorTest, WorksWithStandardAlgorithms) {
+    TestArray arr;
+    for (int i = 0; i < 1000; ++i) arr.push_back((i * 7919) % 1000);
+
+    std::sort(arr.begin(), arr.end());
+    for (size_t i = 0; i < arr.length(); ++i)
+        ASSERT_EQ(arr.get(i), static_cast<int>(i)) << "std::sort must fully order the array";
+
+    auto pos = std::lower_bound(arr.begin(), arr.end(), 640);
+    EXPECT_EQ(pos - arr.begin(), 640);
+    EXPECT_EQ(*pos, 640);
+
+    const TestArray& constArr = arr;
+    EXPECT_TRUE(std::is_sorted(constArr.begin(), constArr.end()));
+}
+
+// =======================================================================
+//  segments() / for_each_segment()
+// =======================================================================
+
+TEST(SegmentTest, SegmentsCoverArrayInIndexOrder) {
+    TestArray arr;
+    for (int i = 0; i < 777; ++i) arr.push_back(i);
+
+    size_t seen = 0;
+    size_t count = 0;
+    for (std::span<int> segment : arr.segments()) {
+        ASSERT_FALSE(segment.empty()) << "Segments must never be empty";
+        for (int x : segment) {
+            ASSERT_EQ(x, static_cast<int>(seen)) << "Segments must follow index order";
+            ++seen;
+        }
+        ++count;
+    }
+    EXPECT_EQ(seen, arr.length()) << "Segments must cover every element exactly once";
+
+    // One segment per allocated block: levels R-1..2 plus level 1.
+    size_t blocks = 0;
+    for (size_t lvl = 1; lvl < 3; ++lvl) blocks += arr.n_[lvl];
+    EXPECT_EQ(count, blocks);
+
+    // The last segment is the partial level-1 block.
+    std::span<int> last;
+    for (std::span<int> segment : arr.segments()) last = segment;
+    EXPECT_EQ(last.size(), arr.n0_);
+}
+
+TEST(SegmentTest, ForEachSegmentAllowsBulkModification) {
+    TestArray arr;
+    for (int i = 0; i < 200; ++i) arr.push_back(i);
+
+    arr.for_each_segment([](std::span<int> segment) {
+        std::transform(segment.begin(), segment.end(), segment.begin(), [](int x) { return x * 3; });
+    });
+
+    long long sum = 0;
+    const TestArray& constArr = arr;
+    constArr.for_each_segment([&](std::span<const int> segment) {
+        for (int x : segment) sum += x;
+    });
+    EXPECT_EQ(sum, 3LL * 199 * 200 / 2);
+    EXPECT_EQ(arr.get(199), 597);
+}
+
+TEST(SegmentTest, EmptyArrayHasNoSegments) {
+    TestArray arr;
+    EXPECT_TRUE(arr.segments().begin() == arr.segments().end());
+
+    arr.push_back(1);
+    arr.shrink();
+    size_t count = 0;
+    arr.for_each_segment([&](std::span<int>) { ++count; });
+    EXPECT_EQ(count, 0u) << "No segments must remain after shrinking to empty";
+}
+
 // =======================================================================
 //  filter()
 // =======================================================================
@@ -963,6 +2043,84 @@ TEST(FilterTest, OriginalArrayUnchanged) {
     EXPECT_EQ(result.get(2), 2);
 }
 
+TEST(FilterTest, BlockwiseFilterMatchesScalarAcrossGeometries) {
+    ResizableArray<long long, 3> big;
+    std::vector<long long> ref;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 70000; ++i) {
+        const long long v = static_cast<long long>(rng() % 1000);
+        big.push_back(v);
+        if (v % 3 != 0) ref.push_back(v);
+    }
+
+    auto result = big.filter([](long long x) { return x % 3 != 0; });
+    ASSERT_EQ(result.length(), ref.size());
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), ref.begin()));
+
+    // výsledok je bežné pole v platnom stave
+    TestArray ref2;
+    for (size_t i = 0; i < ref.size(); ++i) ref2.push_back(0);
+    EXPECT_EQ(result.getParameterB(), ref2.getParameterB());
+    while (!result.empty()) result.shrink();
+
+    // nič nevyhovuje / všetko vyhovuje
+    EXPECT_TRUE(big.filter([](long long) { return false; }).empty());
+    EXPECT_EQ(big.filter([](long long) { return true; }).length(), big.length());
+
+    // netriviálny typ ide pôvodnou cestou
+    ResizableArray<std::string, 3> words;
+    for (int i = 0; i < 50; ++i) words.push_back(std::to_string(i));
+    auto twoDigit = words.filter([](const std::string& w) { return w.size() == 2; });
+    ASSERT_EQ(twoDigit.length(), 40u);
+    EXPECT_EQ(twoDigit.get(0), "10");
+}
+
+// =======================================================================
+//  reduce(), sum(), min(), max(), count_if(), find()
+// =======================================================================
+
+TEST(ReductionTest, BlockwiseReductionsMatchScalar) {
+    TestArray arr;
+    std::vector<int> ref;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 30000; ++i) {
+        const int v = static_cast<int>(rng() % 2001) - 1000;
+        arr.push_back(v);
+        ref.push_back(v);
+    }
+
+    long long refSum = 0;
+    for (int v : ref) refSum += v;
+    EXPECT_EQ(arr.sum(), static_cast<int>(refSum));
+    EXPECT_EQ(arr.reduce(0LL, [](long long a, int b) { return a + b; }), refSum);
+    EXPECT_EQ(arr.min(), *std::min_element(ref.begin(), ref.end()));
+    EXPECT_EQ(arr.max(), *std::max_element(ref.begin(), ref.end()));
+    EXPECT_EQ(arr.count_if([](int x) { return x > 500; }),
+              static_cast<size_t>(std::count_if(ref.begin(), ref.end(), [](int x) { return x > 500; })));
+
+    arr.set(12345, 5000);
+    EXPECT_EQ(arr.find(5000), 12345u);
+    EXPECT_EQ(arr.find(ref[0]), 0u);
+    EXPECT_EQ(arr.find(99999), arr.length());
+}
+
+TEST(ReductionTest, EmptyAndMigratingArrays) {
+    TestArray empty;
+    EXPECT_EQ(empty.sum(), 0);
+    EXPECT_EQ(empty.count_if([](int) { return true; }), 0u);
+    EXPECT_EQ(empty.find(1), 0u);
+    EXPECT_THROW(empty.min(), std::out_of_range);
+    EXPECT_THROW(empty.max(), std::out_of_range);
+
+    TestArray arr;
+    arr.setIncrementalRebuild(true);
+    for (int i = 1; i <= 70; ++i) arr.push_back(i);
+    ASSERT_TRUE(arr.rebuildInProgress());
+    EXPECT_EQ(arr.sum(), 70 * 71 / 2);
+    EXPECT_EQ(arr.max(), 70);
+    EXPECT_EQ(arr.find(69), 68u); // v starej geometrii
+}
+
 // =======================================================================
 //  flatten()
 // =======================================================================
@@ -1001,4 +2159,599 @@ TEST(FlattenTest, WorksWithResizableArray) {
     EXPECT_EQ(flat.get(0), 5);
     EXPECT_EQ(flat.get(1), 6);
     EXPECT_EQ(flat.get(2), 7);
+}
+// =======================================================================
+//  Paralelné operácie (rarray_exec::seq / par)
+// =======================================================================
+
+TEST(ParallelTest, PoliciesMatchSerialResults) {
+    ResizableArray<int, 3> arr;
+    for (int i = 0; i < 50000; ++i) arr.push_back(i);
+
+    auto odd = [](int x) { return x % 2 != 0; };
+    const rarray_exec::parallel_policy four{4};
+
+    auto serial = arr.filter(odd);
+    for (auto result : {arr.filter(rarray_exec::seq, odd), arr.filter(rarray_exec::par, odd),
+                        arr.filter(four, odd)}) {
+        ASSERT_EQ(result.length(), serial.length());
+        EXPECT_TRUE(std::equal(result.begin(), result.end(), serial.begin()));
+        while (!result.empty()) result.shrink();
+    }
+
+    auto sub = arr.sub_rarray(four, 123, 45678);
+    ASSERT_EQ(sub.length(), 45678u - 123u);
+    for (size_t i = 0; i < sub.length(); ++i) ASSERT_EQ(sub.get(i), static_cast<int>(i + 123)) << "at " << i;
+    EXPECT_TRUE(arr.sub_rarray(four, 7, 7).empty());
+    EXPECT_THROW(arr.sub_rarray(four, 5, 50001), std::out_of_range);
+
+    auto squares = arr.transform(four, [](const int& x) { return static_cast<long long>(x) * x; });
+    static_assert(std::is_same_v<decltype(squares), ResizableArray<long long, 3>>);
+    ASSERT_EQ(squares.length(), arr.length());
+    EXPECT_EQ(squares.get(49999), 49999LL * 49999LL);
+    squares.push_back(1); // výsledok je bežné pole
+    EXPECT_EQ(squares.length(), 50001u);
+
+    arr.for_each(four, [](int& x) { x = -x; });
+    for (size_t i = 0; i < arr.length(); ++i) ASSERT_EQ(arr.get(i), -static_cast<int>(i)) << "at " << i;
+}
+
+TEST(ParallelTest, NonTrivialTypesAndFlattenStitchPartials) {
+    const rarray_exec::parallel_policy three{3};
+
+    ResizableArray<std::string, 3> words;
+    for (int i = 0; i < 1000; ++i) words.push_back(std::to_string(i));
+
+    auto sub = words.sub_rarray(three, 10, 990);
+    ASSERT_EQ(sub.length(), 980u);
+    EXPECT_EQ(sub.get(0), "10");
+    EXPECT_EQ(sub.get(979), "989");
+
+    auto lengths = words.transform(three, [](const std::string& w) { return w + "!"; });
+    EXPECT_EQ(lengths.get(999), "999!");
+
+    ResizableArray<std::vector<int>, 3> nested;
+    std::vector<int> ref;
+    for (int i = 0; i < 300; ++i) {
+        nested.push_back(std::vector<int>(static_cast<size_t>(i % 7), i));
+        ref.insert(ref.end(), static_cast<size_t>(i % 7), i);
+    }
+    auto flat = nested.flatten<int>(three);
+    ASSERT_EQ(flat.length(), ref.size());
+    EXPECT_TRUE(std::equal(flat.begin(), flat.end(), ref.begin()));
+}
+
+TEST(ParallelTest, WorkerExceptionIsRethrown) {
+    ResizableArray<int, 3> arr;
+    for (int i = 0; i < 1000; ++i) arr.push_back(i);
+
+    auto throwing = [](int x) -> bool {
+        if (x == 900) throw std::runtime_error("boom");
+        return true;
+    };
+    EXPECT_THROW(arr.filter(rarray_exec::parallel_policy{4}, throwing), std::runtime_error);
+    EXPECT_EQ(arr.length(), 1000u);
+}
+
+TEST(ParallelTest, WorksDuringIncrementalRebuild) {
+    ResizableArray<int, 3> arr;
+    arr.setIncrementalRebuild(true);
+    int i = 0;
+    while (!arr.rebuildInProgress()) arr.push_back(i++);
+    arr.push_back(i++);
+    ASSERT_TRUE(arr.rebuildInProgress());
+
+    auto copy = arr.sub_rarray(rarray_exec::parallel_policy{2}, 0, arr.length());
+    ASSERT_EQ(copy.length(), arr.length());
+    for (size_t k = 0; k < copy.length(); ++k) ASSERT_EQ(copy.get(k), arr.get(k)) << "at " << k;
+
+    auto evens = arr.filter(rarray_exec::parallel_policy{2}, [](int x) { return x % 2 == 0; });
+    EXPECT_EQ(evens.length(), (arr.length() + 1) / 2);
+}
+
+// =======================================================================
+//  ConcurrentRArray - jeden zapisovateľ, čitatelia bez zámkov
+// =======================================================================
+
+TEST(ConcurrentTest, ReadersSeeConsistentPrefixWhileWriterGrows) {
+    ConcurrentRArray<int, 3> arr(8);
+    constexpr int COUNT = 200000;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&, t] {
+            auto reader = arr.reader();
+            std::mt19937 rng(static_cast<unsigned>(t));
+            while (!done.load()) {
+                auto view = reader.pin();
+                const size_t len = view.length();
+                if (len == 0) continue;
+                // každá pripnutá snímka je platný prefix: arr[i] == i
+                if (view[len - 1] != static_cast<int>(len - 1)) failures++;
+                const size_t i = rng() % len;
+                if (view[i] != static_cast<int>(i)) failures++;
+            }
+        });
+    }
+
+    for (int i = 0; i < COUNT; ++i) arr.push_back(i);
+    done = true;
+    for (std::thread& t : readers) t.join();
+
+    EXPECT_EQ(failures.load(), 0u);
+    ASSERT_EQ(arr.length(), static_cast<size_t>(COUNT));
+    arr.reclaim();
+    EXPECT_EQ(arr.pendingReclaim(), 0u) << "Without pinned readers everything is reclaimed";
+}
+
+TEST(ConcurrentTest, PinnedSnapshotKeepsRetiredBlocksAlive) {
+    ConcurrentRArray<int, 3> arr(2);
+    for (int i = 0; i < 1000; ++i) arr.push_back(i);
+
+    auto reader = arr.reader();
+    auto other = arr.reader();
+    EXPECT_THROW(arr.reader(), std::runtime_error);
+
+    {
+        auto view = reader.pin();
+        // zapisovateľ prestaví štruktúru (combine, rebuild, shrink/split)
+        for (int i = 1000; i < 50000; ++i) arr.push_back(i);
+        for (int i = 0; i < 45000; ++i) arr.shrink();
+        arr.reclaim();
+        EXPECT_GT(arr.pendingReclaim(), 0u);
+
+        ASSERT_EQ(view.length(), 1000u);
+        size_t seen = 0;
+        view.for_each_segment([&](std::span<const int> segment) {
+            for (int x : segment) EXPECT_EQ(x, static_cast<int>(seen++));
+        });
+        EXPECT_EQ(seen, 1000u);
+        EXPECT_THROW(view.get(1000), std::out_of_range);
+    }
+
+    arr.reclaim();
+    EXPECT_EQ(arr.pendingReclaim(), 0u);
+    EXPECT_EQ(other.length(), 5000u);
+    EXPECT_EQ(other.get(4999), 4999);
+}
+
+TEST(ConcurrentTest, NestedPinKeepsOuterSnapshotPinned) {
+    ConcurrentRArray<int, 3> arr(1);
+    for (int i = 0; i < 1000; ++i) arr.push_back(i);
+    auto reader = arr.reader();
+
+    auto outer = reader.pin();
+    // jednorazové čítanie si pripne a pustí vlastnú snímku - vonkajšia musí ostať pripnutá
+    EXPECT_EQ(reader.length(), 1000u);
+    {
+        auto inner = reader.pin();
+        EXPECT_EQ(inner.length(), 1000u);
+    }
+
+    for (int i = 1000; i < 50000; ++i) arr.push_back(i);
+    for (int i = 0; i < 45000; ++i) arr.shrink();
+    arr.reclaim();
+    EXPECT_GT(arr.pendingReclaim(), 0u) << "Blocks of the outer snapshot must not be freed";
+    for (size_t i = 0; i < outer.length(); ++i) ASSERT_EQ(outer[i], static_cast<int>(i));
+}
+
+// =======================================================================
+//  Serializácia (rarray_io)
+// =======================================================================
+
+namespace {
+// Dočasný súbor, ktorý sa na konci testu zmaže
+struct TempFile {
+    std::string path;
+    explicit TempFile(const char* name)
+        : path((std::filesystem::temp_directory_path() / (std::string(name) + "_" + std::to_string(::getpid()))).string()) {}
+    ~TempFile() { std::filesystem::remove(path); }
+};
+} // namespace
+
+TEST(SerializationTest, SaveLoadKeepsGeometryAndContent) {
+    TestArray arr;
+    for (int i = 0; i < 30000; ++i) arr.push_back(i * 7);
+    for (int i = 0; i < 1234; ++i) arr.shrink();
+
+    std::stringstream buf;
+    rarray_io::save(arr, buf);
+    auto loaded = rarray_io::load<int, 3>(buf);
+
+    ASSERT_EQ(loaded.length(), arr.length());
+    EXPECT_EQ(loaded.getParameterB(), arr.getParameterB());
+    EXPECT_EQ(loaded.n0_, arr.n0_);
+    for (size_t i = 0; i < 3; ++i) EXPECT_EQ(loaded.n_[i], arr.n_[i]);
+    EXPECT_TRUE(std::equal(loaded.begin(), loaded.end(), arr.begin()));
+
+    // načítané pole je bežné pole
+    for (int i = 0; i < 5000; ++i) loaded.push_back(-i);
+    while (!loaded.empty()) loaded.shrink();
+
+    TestArray empty;
+    std::stringstream emptyBuf;
+    rarray_io::save(empty, emptyBuf);
+    EXPECT_TRUE((rarray_io::load<int, 3>(emptyBuf).empty()));
+}
+
+TEST(SerializationTest, RejectsForeignOrCorruptData) {
+    TestArray arr;
+    for (int i = 0; i < 100; ++i) arr.push_back(i);
+    std::stringstream buf;
+    rarray_io::save(arr, buf);
+    const std::string bytes = buf.str();
+
+    std::stringstream wrongType(bytes);
+    EXPECT_THROW((rarray_io::load<long long, 3>(wrongType)), std::runtime_error);
+    std::stringstream wrongR(bytes);
+    EXPECT_THROW((rarray_io::load<int, 4>(wrongR)), std::runtime_error);
+
+    std::string corrupt = bytes;
+    corrupt[offsetof(rarray_io::FileHeader, length)] ^= 1; // dĺžka nesedí s blokmi
+    std::stringstream corruptIn(corrupt);
+    EXPECT_THROW((rarray_io::load<int, 3>(corruptIn)), std::runtime_error);
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 64));
+    EXPECT_THROW((rarray_io::load<int, 3>(truncated)), std::runtime_error);
+}
+
+namespace {
+// Hlavička s ľubovoľnou geometriou, bez dát blokov (súbor "skrátený" na hlavičku)
+template<size_t R>
+std::string craftedHeader(uint64_t B, const uint64_t (&n)[R], uint64_t length, uint64_t n0) {
+    rarray_io::FileHeader h{};
+    std::memcpy(h.magic, rarray_io::MAGIC, sizeof(h.magic));
+    h.byteOrder    = rarray_io::BYTE_ORDER_TAG;
+    h.version      = rarray_io::VERSION;
+    h.elementSize  = sizeof(int);
+    h.elementAlign = alignof(int);
+    h.levels       = R;
+    h.B            = B;
+    h.length       = length;
+    h.n0           = n0;
+    std::string bytes(rarray_io::detail::headerBytes<R>(), '\0');
+    std::memcpy(bytes.data(), &h, sizeof(h));
+    std::memcpy(bytes.data() + sizeof(h), n, sizeof(n));
+    return bytes;
+}
+} // namespace
+
+TEST(SerializationTest, RejectsOversizedGeometry) {
+    TempFile tmp("rarray_crafted_test");
+    auto expectRejected = [&](const std::string& bytes, auto loadIt, auto mapIt) {
+        std::stringstream in(bytes);
+        EXPECT_THROW(loadIt(in), std::runtime_error);
+        {
+            std::ofstream out(tmp.path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+        rarray_io::MappedFile file(tmp.path);
+        EXPECT_THROW(mapIt(file), std::runtime_error);
+    };
+    auto load2 = [](std::istream& in) { return rarray_io::load<int, 2>(in); };
+    auto map2  = [](rarray_io::MappedFile& f) { return rarray_io::map<int, 2>(f); };
+    auto load3 = [](std::istream& in) { return rarray_io::load<int, 3>(in); };
+    auto map3  = [](rarray_io::MappedFile& f) { return rarray_io::map<int, 3>(f); };
+
+    // B^(R-1) * sizeof(T) pretečie
+    expectRejected(craftedHeader<2>(uint64_t{1} << 62, {0, 1}, 100, 100), load2, map2);
+    // blok sa dá adresovať, ale v súbore nie je
+    expectRejected(craftedHeader<2>(uint64_t{1} << 40, {0, 1}, 100, 100), load2, map2);
+    // súčet veľkostí blokov pretečie
+    const uint64_t B = uint64_t{1} << 29;
+    expectRejected(craftedHeader<3>(B, {0, 0, 16}, 16 * B * B, 0), load3, map3);
+    // dĺžka nad B^R: bloky sedia, ale combineBlocks/rebuild by s takým poľom nefungovali
+    expectRejected(craftedHeader<3>(2, {0, 1, 40}, 40 * 4 + 2, 2), load3, map3);
+    expectRejected(craftedHeader<2>(2, {0, 10}, 9 * 2 + 2, 2), load2, map2);
+
+    // plné pole (N == B^R) je platné
+    TestArray full;
+    while (full.length() < full.power(full.getParameterB(), 3)) full.push_back(1);
+    std::stringstream fullBuf;
+    rarray_io::save(full, fullBuf);
+    auto loaded = rarray_io::load<int, 3>(fullBuf);
+    EXPECT_EQ(loaded.length(), full.length());
+    loaded.push_back(2);
+    EXPECT_GT(loaded.getParameterB(), full.getParameterB());
+}
+
+TEST(SerializationTest, MappedFileExposesBlocksWithoutCopying) {
+    TestArray arr;
+    for (int i = 0; i < 70000; ++i) arr.push_back(i);
+    arr.setIncrementalRebuild(true);
+    while (!arr.rebuildInProgress()) arr.push_back(static_cast<int>(arr.length()));
+
+    TempFile tmp("rarray_map_test");
+    rarray_io::saveFile(arr, tmp.path); // počas rebuildu sa uloží kanonický tvar
+
+    {
+        rarray_io::MappedFile file(tmp.path, rarray_io::MappedFile::Mode::ReadOnly);
+        // zapisovateľné pole nad stránkami len na čítanie by padlo pri prvom zápise
+        EXPECT_THROW((rarray_io::map<int, 3>(file)), std::invalid_argument);
+        auto mapped = rarray_io::mapReadOnly<int, 3>(file);
+        static_assert(std::is_const_v<std::remove_reference_t<decltype(*mapped)>>);
+        ASSERT_EQ(mapped.length(), arr.length());
+        EXPECT_TRUE(file.contains(&mapped.get(0))) << "Elements must live in the mapping";
+        EXPECT_TRUE(std::equal(mapped.begin(), mapped.end(), arr.begin()));
+        EXPECT_EQ(mapped->get(mapped.length() - 1), arr.get(arr.length() - 1));
+    }
+
+    {
+        rarray_io::MappedFile file(tmp.path, rarray_io::MappedFile::Mode::CopyOnWrite);
+        auto mapped = rarray_io::map<int, 3>(file);
+        mapped.set(0, -1);
+        for (int i = 0; i < 100000; ++i) mapped.push_back(i);
+        EXPECT_EQ(mapped.get(0), -1);
+        while (mapped.length() > 10) mapped.shrink();
+        EXPECT_EQ(mapped.get(9), 9);
+    }
+
+    // súbor ostal nezmenený
+    auto reloaded = rarray_io::loadFile<int, 3>(tmp.path);
+    ASSERT_EQ(reloaded.length(), arr.length());
+    EXPECT_EQ(reloaded.get(0), 0);
+    EXPECT_TRUE(std::equal(reloaded.begin(), reloaded.end(), arr.begin()));
+}
+
+// =======================================================================
+//  Bloky v súbore (rarray_storage)
+// =======================================================================
+
+TEST(FileBackedStorageTest, LargeBlocksLiveInFileTailStaysInMemory) {
+    rarray_storage::FileBackedResource disk(std::filesystem::temp_directory_path().string(), 4096);
+    {
+        TestArray arr;
+        arr.setLargeBlockResource(2, &disk);
+        for (int i = 0; i < 300000; ++i) arr.push_back(i);
+
+        ASSERT_GT(arr.n_[2], 0u);
+        for (size_t j = 0; j < arr.n_[2]; ++j) {
+            EXPECT_EQ(arr.levels_[2][j]->resource, &disk);
+            EXPECT_TRUE(disk.owns(arr.levels_[2][j]->data));
+        }
+        for (size_t j = 0; j < arr.n_[1]; ++j) EXPECT_NE(arr.levels_[1][j]->resource, &disk);
+        EXPECT_GE(disk.mappedBytes(), arr.n_[2] * arr.layout_.blockSize[2] * sizeof(int));
+
+        for (int i = 0; i < 300000; ++i) ASSERT_EQ(arr.get(i), i);
+
+        // presun prevezme nastavenie, rebuildy pri zmenšovaní ho zachovajú
+        TestArray moved(std::move(arr));
+        EXPECT_EQ(moved.largeBlockResource(), &disk);
+        while (moved.length() > 1000) moved.shrink();
+        for (int i = 0; i < 1000; ++i) ASSERT_EQ(moved.get(i), i);
+    }
+    EXPECT_EQ(disk.mappedBytes(), 0u);
+
+    // uvoľnené úseky súboru sa použijú znova
+    const size_t fileBytes = disk.fileBytes();
+    {
+        TestArray again;
+        again.setLargeBlockResource(2, &disk);
+        for (int i = 0; i < 300000; ++i) again.push_back(i);
+    }
+    EXPECT_LE(disk.fileBytes(), fileBytes);
+
+    TestArray arr;
+    EXPECT_THROW(arr.setLargeBlockResource(0, &disk), std::invalid_argument);
+    EXPECT_THROW(arr.setLargeBlockResource(3, &disk), std::invalid_argument);
+}
+
+TEST(HugePageTest, BlocksAreCacheLineAlignedAndLargeBlocksPageAligned) {
+    struct alignas(16) Pair { double a, b; };
+    ResizableArray<Pair, 3> pairs;
+    ResizableArray<char, 2> chars;
+    for (int i = 0; i < 5000; ++i) {
+        pairs.push_back(Pair{double(i), 0});
+        chars.push_back(char(i));
+        if (i % 7 == 0) chars.shrink();
+    }
+    for (size_t lvl = 1; lvl < 3; ++lvl)
+        for (size_t j = 0; j < pairs.n_[lvl]; ++j)
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(pairs.levels_[lvl][j]->data) % 64, 0u);
+    for (size_t j = 0; j < chars.n_[1]; ++j)
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(chars.levels_[1][j]->data) % 64, 0u);
+
+    using rarray_storage::HugePageResource;
+    HugePageResource huge(HugePageResource::Mode::Transparent, HugePageResource::PAGE_2M, 16 * 1024);
+    {
+        TestArray arr;
+        arr.setLargeBlockResource(2, &huge);
+        for (int i = 0; i < 200000; ++i) arr.push_back(i);
+        ASSERT_GT(arr.n_[2], 0u);
+        ASSERT_GE(arr.layout_.blockSize[2] * sizeof(int), huge.minBytes());
+        for (size_t j = 0; j < arr.n_[2]; ++j) {
+            const auto addr = reinterpret_cast<uintptr_t>(arr.levels_[2][j]->data);
+            EXPECT_EQ(addr % HugePageResource::PAGE_2M, 0u);
+        }
+        EXPECT_GT(huge.mappedBytes(), 0u);
+        for (int i = 0; i < 200000; ++i) ASSERT_EQ(arr.get(i), i);
+        while (!arr.empty()) arr.shrink();
+    }
+    EXPECT_EQ(huge.mappedBytes(), 0u);
+
+    // Explicit berie rezervované 2 MB stránky, bez nich sa správa ako Transparent
+    size_t freeHuge = 0;
+    std::ifstream("/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages") >> freeHuge;
+    HugePageResource hugetlb(HugePageResource::Mode::Explicit);
+    void* p = hugetlb.allocate(3 << 20, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % HugePageResource::PAGE_2M, 0u);
+    static_cast<char*>(p)[(3 << 20) - 1] = 1;
+    if (freeHuge == 0) {
+        EXPECT_EQ(hugetlb.hugetlbAllocations(), 0u) << "No reserved pages: must fall back";
+    } else if (freeHuge >= 2) {
+        EXPECT_EQ(hugetlb.hugetlbAllocations(), 1u) << "Reserved pages available: must use them";
+    } // jedna voľná stránka na 3 MB nestačí, ale môže ju medzitým uvoľniť iný proces
+    hugetlb.deallocate(p, 3 << 20, 64);
+    EXPECT_EQ(hugetlb.mappedBytes(), 0u);
+    EXPECT_EQ(hugetlb.hugetlbAllocations(), 0u);
+
+    EXPECT_THROW(HugePageResource(HugePageResource::Mode::Transparent, 4096), std::invalid_argument);
+}
+
+// =======================================================================
+//  scan (prechod s krokom a prefetchom)
+// =======================================================================
+
+namespace {
+template<typename Arr>
+void expectScanMatches(const Arr& arr, size_t from, std::ptrdiff_t stride) {
+    std::vector<int> expected;
+    for (std::ptrdiff_t i = static_cast<std::ptrdiff_t>(from);
+         i >= 0 && i < static_cast<std::ptrdiff_t>(arr.length()); i += stride) {
+        expected.push_back(arr.get(static_cast<size_t>(i)));
+    }
+    std::vector<int> seen;
+    arr.scan(from, stride, [&](const int& x) { seen.push_back(x); });
+    ASSERT_EQ(seen, expected) << "from " << from << " stride " << stride;
+}
+} // namespace
+
+TEST(ScanTest, StridedAndReverseMatchIndexing) {
+    auto check = [](auto& arr) {
+        const size_t n = arr.length();
+        for (std::ptrdiff_t stride : {1, 2, 3, 7, 64, 1000, 100000}) {
+            for (size_t from : {size_t{0}, size_t{5}, n / 3, n - 1}) {
+                expectScanMatches(arr, from, stride);
+                expectScanMatches(arr, from, -stride);
+            }
+        }
+    };
+    ResizableArray<int, 2> a2;
+    TestArray a3;
+    ResizableArray<int, 4> a4;
+    for (int i = 0; i < 40000; ++i) {
+        a2.push_back(i);
+        a3.push_back(i);
+        a4.push_back(i);
+    }
+    check(a2);
+    check(a3);
+    check(a4);
+
+    // počas postupného rebuildu prechádza aj prvky old_
+    TestArray migrating;
+    migrating.setIncrementalRebuild(true);
+    while (!migrating.rebuildInProgress()) migrating.push_back(static_cast<int>(migrating.length()));
+    migrating.push_back(-1);
+    ASSERT_TRUE(migrating.rebuildInProgress());
+    check(migrating);
+}
+
+TEST(ScanTest, DefaultStartModifyAndErrors) {
+    TestArray arr;
+    for (int i = 0; i < 10000; ++i) arr.push_back(i);
+
+    // odzadu od posledného prvku
+    std::vector<int> tail;
+    arr.scan(-1, [&](int x) { if (tail.size() < 3) tail.push_back(x); });
+    EXPECT_EQ(tail, (std::vector<int>{9999, 9998, 9997}));
+
+    arr.scan(2, [](int& x) { x = -x; });
+    EXPECT_EQ(arr.get(2), -2);
+    EXPECT_EQ(arr.get(3), 3);
+
+    size_t visits = 0;
+    TestArray empty;
+    empty.scan(-4, [&](int) { ++visits; });
+    EXPECT_EQ(visits, 0u);
+
+    EXPECT_THROW(arr.scan(0, [](int) {}), std::invalid_argument);
+    EXPECT_THROW(arr.scan(10000, 1, [](int) {}), std::out_of_range);
+}
+
+// =======================================================================
+//  Lenivý reťazec (rarray_pipeline)
+// =======================================================================
+
+TEST(PipelineTest, FusedChainMatchesEagerSteps) {
+    ResizableArray<std::vector<int>, 3> groups;
+    for (int i = 0; i < 3000; ++i) groups.push_back(std::vector<int>(static_cast<size_t>(i % 5), i));
+    auto nonEmptyOdd = [](const std::vector<int>& g) { return !g.empty() && g[0] % 2 == 1; };
+
+    const auto eager = groups.filter(nonEmptyOdd).flatten<int>().sub_rarray(100, 2000);
+    const auto lazy = rarray_pipe::from(groups).filter(nonEmptyOdd).flatten<int>().sub(100, 2000).to_rarray();
+    ASSERT_EQ(lazy.length(), eager.length());
+    EXPECT_TRUE(std::equal(lazy.begin(), lazy.end(), eager.begin()));
+
+    // známy počet (bez filtra): flatten so sized rozsahmi, sub priamo na zdroji
+    const auto known = rarray_pipe::from(groups).sub(10, 2500).flatten<long long>().to_rarray();
+    const auto knownEager = groups.sub_rarray(10, 2500).flatten<long long>();
+    ASSERT_EQ(known.length(), knownEager.length());
+    EXPECT_TRUE(std::equal(known.begin(), known.end(), knownEager.begin()));
+    EXPECT_EQ(rarray_pipe::from(groups).sub(10, 2500).flatten<long long>().count(), known.length());
+
+    TestArray nums;
+    for (int i = 0; i < 100000; ++i) nums.push_back(i);
+    const auto evens = rarray_pipe::from(nums, 50, 99000).filter([](int x) { return x % 2 == 0; }).to_rarray();
+    ASSERT_EQ(evens.length(), (99000u - 50u) / 2);
+    for (size_t i = 0; i < evens.length(); ++i) ASSERT_EQ(evens[i], 50 + 2 * static_cast<int>(i));
+
+    long long total = 0;
+    rarray_pipe::from(nums).sub(1, 4).for_each([&](int x) { total += x; });
+    EXPECT_EQ(total, 1 + 2 + 3);
+}
+
+TEST(PipelineTest, KnownCountBuildsOnceInCanonicalShape) {
+    TestArray nums;
+    for (int i = 0; i < 200000; ++i) nums.push_back(i);
+
+    auto out = rarray_pipe::from(nums).sub(1000, 150000).to_rarray();
+    ASSERT_EQ(out.length(), 149000u);
+    EXPECT_EQ(out.get(0), 1000);
+    EXPECT_EQ(out.get(148999), 149999);
+
+    // rovnaký tvar ako pri sub_rarray (jedna stavba, nie rast cez push_back)
+    const auto ref = nums.sub_rarray(1000, 150000);
+    EXPECT_EQ(out.getParameterB(), ref.getParameterB());
+    for (size_t i = 0; i < 3; ++i) EXPECT_EQ(out.n_[i], ref.n_[i]);
+}
+
+namespace {
+// Kópia hodí výnimku po copiesLeft úspešných kópiách
+struct CopyBomb {
+    static inline int copiesLeft = 0;
+    LiveCounter c;
+
+    explicit CopyBomb(int v) : c(v) {}
+    CopyBomb(const CopyBomb& other) : c(other.c) {
+        if (copiesLeft-- == 0) throw std::runtime_error("copy failed");
+    }
+    CopyBomb(CopyBomb&&) noexcept = default;
+};
+} // namespace
+
+TEST(PipelineTest, ThrowingElementCopyLeaksNothing) {
+    LiveCounter::live = 0;
+    {
+        ResizableArray<CopyBomb, 3> src;
+        for (int i = 0; i < 5000; ++i) src.push_back(CopyBomb(i));
+        ASSERT_EQ(LiveCounter::live, 5000);
+
+        // známy počet (jedna stavba) aj neznámy (po kusoch)
+        CopyBomb::copiesLeft = 3000;
+        EXPECT_THROW(rarray_pipe::from(src).sub(0, 5000).to_rarray(), std::runtime_error);
+        EXPECT_EQ(LiveCounter::live, 5000) << "Elements copied before the failure must be destroyed";
+
+        CopyBomb::copiesLeft = 3000;
+        EXPECT_THROW(rarray_pipe::from(src).filter([](const CopyBomb&) { return true; }).to_rarray(),
+                     std::runtime_error);
+        EXPECT_EQ(LiveCounter::live, 5000);
+    }
+    EXPECT_EQ(LiveCounter::live, 0);
+}
+
+TEST(PipelineTest, RangeErrors) {
+    TestArray nums;
+    for (int i = 0; i < 100; ++i) nums.push_back(i);
+
+    EXPECT_THROW(rarray_pipe::from(nums, 10, 200), std::out_of_range);
+    EXPECT_THROW(rarray_pipe::from(nums).sub(50, 101), std::out_of_range);
+    EXPECT_THROW(rarray_pipe::from(nums).sub(60, 50), std::out_of_range);
+
+    // pri neznámom počte sa krátky prúd ukáže až pri vyhodnotení
+    auto chain = rarray_pipe::from(nums).filter([](int x) { return x < 10; }).sub(5, 20);
+    EXPECT_THROW(chain.to_rarray(), std::out_of_range);
+    EXPECT_TRUE(rarray_pipe::from(nums).filter([](int) { return false; }).to_rarray().empty());
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include "../include/rdeque.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+
+// RDeque: porovnanie so std::deque pri náhodných operáciách na oboch koncoch
+
+using Deq = RDeque<int, 3>;
+
+namespace {
+void expectSame(const Deq& d, const std::deque<int>& ref) {
+    ASSERT_EQ(d.length(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(d[i], ref[i]) << "index " << i;
+}
+
+// Sleduje živé bajty a ich maximum
+struct PeakResource : std::pmr::memory_resource {
+    size_t live = 0;
+    size_t peak = 0;
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        live += bytes;
+        if (live > peak) peak = live;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Od zapnutia hodí std::bad_alloc pri alokácii číslo budget (počítané od nuly)
+struct FailingResource : std::pmr::memory_resource {
+    size_t budget = SIZE_MAX;
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (budget == 0) throw std::bad_alloc();
+        if (budget != SIZE_MAX) --budget;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Kópia aj presun hodia výnimku pri n-tom volaní (0 = nikdy)
+struct Fragile {
+    static inline int copiesLeft = 0;
+    static inline int movesLeft = 0;
+    int v;
+
+    explicit Fragile(int x) : v(x) {}
+    Fragile(const Fragile& o) : v(o.v) {
+        if (copiesLeft > 0 && --copiesLeft == 0) throw std::runtime_error("copy");
+    }
+    Fragile(Fragile&& o) : v(o.v) {
+        if (movesLeft > 0 && --movesLeft == 0) throw std::runtime_error("move");
+    }
+    Fragile& operator=(const Fragile&) = default;
+    Fragile& operator=(Fragile&&) = default;
+};
+
+void expectRange(const RDeque<Fragile, 3>& d, int first, int last) {
+    ASSERT_EQ(d.length(), static_cast<size_t>(last - first));
+    for (int i = first; i < last; ++i) ASSERT_EQ(d[i - first].v, i) << "index " << i - first;
+}
+} // namespace
+
+TEST(RDequeTest, BothEndsMatchStdDeque) {
+    Deq d;
+    std::deque<int> ref;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 60000; ++step) {
+        const unsigned op = rng() % 100;
+        const int x = static_cast<int>(rng());
+        if (op < 30) {
+            d.push_back(x);
+            ref.push_back(x);
+        } else if (op < 60) {
+            d.push_front(x);
+            ref.push_front(x);
+        } else if (ref.empty()) {
+            EXPECT_THROW(d.pop_front(), std::out_of_range);
+            EXPECT_THROW(d.pop_back(), std::out_of_range);
+        } else if (op < 80) {
+            ASSERT_EQ(d.front(), ref.front());
+            d.pop_front();
+            ref.pop_front();
+        } else {
+            ASSERT_EQ(d.back(), ref.back());
+            d.pop_back();
+            ref.pop_back();
+        }
+        if (step % 5000 == 0) expectSame(d, ref);
+    }
+    expectSame(d, ref);
+    EXPECT_TRUE(std::equal(d.begin(), d.end(), ref.begin(), ref.end()));
+}
+
+TEST(RDequeTest, QueueUsageKeepsMemoryBounded) {
+    // fronta: push_back na konci, pop_front na začiatku - žiadny rastúci offset
+    Deq d;
+    for (int i = 0; i < 1000; ++i) d.push_back(i);
+    int next = 0;
+    for (int i = 1000; i < 500000; ++i) {
+        d.push_back(i);
+        ASSERT_EQ(d.front(), next);
+        d.pop_front();
+        ++next;
+    }
+    ASSERT_EQ(d.length(), 1000u);
+    for (size_t i = 0; i < d.length(); ++i) ASSERT_EQ(d[i], next + static_cast<int>(i));
+
+    // pamäť zodpovedá 1000 živým prvkom, nie 500000 prejdeným
+    const size_t used = d.frontHalf().stats().totalBytes + d.backHalf().stats().totalBytes;
+    EXPECT_LT(used, 8 * 1000 * sizeof(int));
+}
+
+TEST(RDequeTest, StackOnEitherEnd) {
+    Deq d;
+    for (int i = 0; i < 20000; ++i) d.push_front(i);
+    for (int i = 0; i < 20000; ++i) ASSERT_EQ(d[i], 19999 - i);
+    // odoberanie z druhého konca vyrovná polovice
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_EQ(d.back(), i);
+        d.pop_back();
+    }
+    EXPECT_TRUE(d.empty());
+    EXPECT_THROW(d.front(), std::out_of_range);
+    EXPECT_THROW(d.get(0), std::out_of_range);
+}
+
+TEST(RDequeTest, MoveOnlyElements) {
+    RDeque<std::unique_ptr<int>, 2> d;
+    for (int i = 0; i < 300; ++i) {
+        d.push_back(std::make_unique<int>(i));
+        d.push_front(std::make_unique<int>(-i));
+    }
+    for (int i = 0; i < 299; ++i) d.pop_back(); // vyprázdni back_, presun cez rebalance
+    EXPECT_EQ(*d.back(), 0);
+    EXPECT_EQ(*d.front(), -299);
+    d.set(0, std::make_unique<int>(42));
+    EXPECT_EQ(*d[0], 42);
+    d.clear();
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(RDequeTest, ThrowingMoveLeavesDequeIntact) {
+    // Hádžuci presun sa pri vyrovnaní nepoužije, prvky sa kopírujú
+    RDeque<Fragile, 3> d;
+    for (int i = 0; i < 1000; ++i) d.emplace_back(i);
+    Fragile::movesLeft = 801;
+    d.pop_front();
+    Fragile::movesLeft = 0;
+    expectRange(d, 1, 1000);
+
+    // Zlyhaná kópia nechá obe polovice tak, ako boli
+    RDeque<Fragile, 3> e;
+    for (int i = 0; i < 1000; ++i) e.emplace_back(i);
+    Fragile::copiesLeft = 301;
+    EXPECT_THROW(e.pop_front(), std::runtime_error);
+    Fragile::copiesLeft = 0;
+    expectRange(e, 0, 1000);
+    e.pop_front();
+    expectRange(e, 1, 1000);
+}
+
+TEST(RDequeTest, FailedAllocationDuringRebalanceLeavesDequeIntact) {
+    // Neúspešná alokácia v každom kroku vyrovnania (nový blok front_, rozbitie
+    // bloku back_) musí deque nechať nezmenený
+    size_t failures = 0;
+    for (size_t fail = 0;; ++fail) {
+        FailingResource mr;
+        Deq d(&mr);
+        std::deque<int> ref;
+        for (int i = 0; i < 1000; ++i) {
+            d.push_back(i);
+            ref.push_back(i);
+        }
+        mr.budget = fail;
+        try {
+            d.pop_front();
+        } catch (const std::bad_alloc&) {
+            ++failures;
+            mr.budget = SIZE_MAX;
+            expectSame(d, ref);
+            continue;
+        }
+        mr.budget = SIZE_MAX;
+        ref.pop_front();
+        expectSame(d, ref);
+        break;
+    }
+    EXPECT_GT(failures, 10u);
+}
+
+TEST(RDequeTest, RebalanceDoesNotCopyTheWholeHalf) {
+    PeakResource mr;
+    Deq d(&mr);
+    std::deque<int> ref;
+    for (int i = 0; i < 200000; ++i) {
+        d.push_back(i);
+        ref.push_back(i);
+    }
+    ASSERT_TRUE(d.frontHalf().empty());
+
+    // pop_front na prázdnej prednej polovici presunie polovicu back_ do front_
+    const size_t before = mr.live;
+    mr.peak = before;
+    d.pop_front();
+    ref.pop_front();
+    EXPECT_FALSE(d.frontHalf().empty());
+    EXPECT_FALSE(d.backHalf().empty());
+    expectSame(d, ref);
+
+    // navyše smie byť len rozpracovaný blok, nie druhá kópia polovice prvkov
+    EXPECT_LT(mr.peak - before, before / 8) << "peak " << mr.peak << " live before " << before;
+}